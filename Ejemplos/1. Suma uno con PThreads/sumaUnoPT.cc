@@ -1,11 +1,28 @@
 /**
  *  Suma uno a un total mil veces por cada proceso generado
- *  Recibe como parametro la cantidad de procesos que se quiere arrancar
+ *  Recibe como parametros la cantidad de procesos que se quiere arrancar,
+ *  la cantidad de sumas de cada proceso y la pausa (en microsegundos) despues
+ *  de cada suma, 0 para no hacer pausa
  *  Author: Arquitectura de computadores (Francisco Arroyo)
  *  Version: 2021/Abr/12
  *
  *  Compilar con:
  *   g++ -g sumaUnoPT.cc -lpthread
+ *
+ *  Para incluir la version con std::execution::par (necesita TBB):
+ *   g++ -g -std=c++17 -DUSE_PARALLEL_STL sumaUnoPT.cc -lpthread -ltbb
+ *
+ *  Uso:
+ *   ./a.out [-w calentamiento] [-r repeticiones] [-p] [-s] [hilos [iteraciones [pausa]]]
+ *
+ *   -w  corridas de calentamiento antes de medir (1 por omision)
+ *   -r  corridas medidas de cada version (5 por omision)
+ *   -p  fija cada hilo a un procesador
+ *   -s  mide con 1, 2, 4, ... hasta "hilos" hilos
+ *
+ *  Imprime una linea CSV por version y cantidad de hilos, con la mediana,
+ *  el percentil 99 y el minimo del tiempo real, la mediana del tiempo de CPU
+ *  y, en x86, la mediana de los ciclos del contador de tiempo (rdtsc)
 **/
 
 #include <stdlib.h>
@@ -13,9 +30,23 @@
 #include <unistd.h>
 #include <time.h>
 #include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
 #include <thread>
 #include <vector>
-#include <sys/time.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+#if defined( USE_PARALLEL_STL ) && __has_include( <execution> )
+#include <execution>
+#include <numeric>
+#endif
+
+// Tamano de una linea de cache
+#define LINEA_CACHE 64
 
 // Shared variables
 long total;
@@ -26,40 +57,156 @@ struct cosita {
    float r;
 };
 
+// Parametros de las pruebas
+long iteraciones = 1000;
+long pausa = 1;
+long calentamiento = 1;
+long repeticiones = 5;
+bool fijar = false;
+
+// Total para la version con std::atomic
+std::atomic< long > totalAtomico;
+
+// Sumas parciales de cada hilo, una por linea de cache
+struct alignas( LINEA_CACHE ) SumaParcial {
+   long valor;
+};
+SumaParcial * parciales;
+
+// Sumas parciales de cada hilo, contiguas: varios hilos comparten linea
+long * compartidas;
+
+
+/*
+ *  Version que se puede medir: recibe la cantidad de hilos y deja la suma en total
+ */
+struct Prueba {
+   const char * nombre;
+   long ( * funcion )( long );
+};
+
+/*
+ *  Estadisticas de las corridas medidas de una version
+ */
+struct Medicion {
+   long total;
+   bool correcto;
+   double wallMediana;
+   double wallP99;
+   double wallMinimo;
+   double cpuMediana;
+   double ciclosMediana;
+};
+
+
+/*
+ *  Fija el hilo que la invoca al procesador "hilo" modulo los procesadores
+ *  disponibles, si se pidio con -p
+ */
+void Fijar( long hilo ) {
+   if ( fijar ) {
+      long procesadores = sysconf( _SC_NPROCESSORS_ONLN );
+      cpu_set_t conjunto;
+
+      CPU_ZERO( & conjunto );
+      CPU_SET( hilo % ( procesadores > 0 ? procesadores : 1 ), & conjunto );
+      pthread_setaffinity_np( pthread_self(), sizeof( conjunto ), & conjunto );
+   }
+}
+
+
+/*
+ *  Simula el trabajo de cada suma
+ */
+inline void Trabajo() {
+   if ( pausa > 0 ) {
+      usleep( pausa );
+   }
+}
+
 
 /*
  *  Do some work, by now add one to a variable
  */
-int AddOneWithMutex( long hilo ) {
-   int i;
+void AddOneWithMutex( long hilo ) {
+   long i;
    long myTotal = 0;
 
-   for ( i = 0; i < 1000; i++ ) {
+   Fijar( hilo );
+   for ( i = 0; i < iteraciones; i++ ) {
       myTotal++;
-      usleep( 1 );
+      Trabajo();
    }
 
    pthread_mutex_lock( mutex );
    total += myTotal;
    pthread_mutex_unlock( mutex );
 
-   pthread_exit( 0 );
-
 }
 
 
 /*
  *  Do some work, by now add one to a variable
  */
-int AddOne( long hilo ) {
-   int i;
+void AddOne( long hilo ) {
+   long i;
 
-   for ( i = 0; i < 1000; i++ ) {
+   Fijar( hilo );
+   for ( i = 0; i < iteraciones; i++ ) {
       total++;
-      usleep( 1 );
+      Trabajo();
    }
 
-   pthread_exit( 0 );
+}
+
+
+/*
+ *  Suma uno con una operacion atomica por cada iteracion
+ */
+void AddOneAtomic( long hilo ) {
+   long i;
+
+   Fijar( hilo );
+   for ( i = 0; i < iteraciones; i++ ) {
+      totalAtomico.fetch_add( 1, std::memory_order_relaxed );
+      Trabajo();
+   }
+
+}
+
+
+/*
+ *  Suma uno a la suma parcial del hilo, que esta sola en su linea de cache
+ *  volatile obliga a escribir en memoria en cada iteracion
+ */
+void AddOnePadded( long hilo ) {
+   long i;
+   volatile long * miSuma = & parciales[ hilo ].valor;
+
+   Fijar( hilo );
+
+   for ( i = 0; i < iteraciones; i++ ) {
+      *miSuma = *miSuma + 1;
+      Trabajo();
+   }
+
+}
+
+
+/*
+ *  Suma uno a la suma parcial del hilo, que comparte linea de cache con
+ *  las de otros hilos (false sharing)
+ */
+void AddOneFalseSharing( long hilo ) {
+   long i;
+   volatile long * miSuma = & compartidas[ hilo ];
+
+   Fijar( hilo );
+
+   for ( i = 0; i < iteraciones; i++ ) {
+      *miSuma = *miSuma + 1;
+      Trabajo();
+   }
 
 }
 
@@ -69,16 +216,24 @@ int AddOne( long hilo ) {
 */
 long SerialTest( long hilos ) {
    long i, hilo;
+   cpu_set_t original;
+
+   // El hilo principal crea los hilos de las otras variantes, que heredan
+   // su afinidad, asi que se restaura al terminar
+   pthread_getaffinity_np( pthread_self(), sizeof( original ), & original );
+   Fijar( 0 );
 
    for ( hilo = 0; hilo < hilos; hilo++ ) {
 
-      for ( i = 0; i < 1000; i++ ) {
+      for ( i = 0; i < iteraciones; i++ ) {
          total++;			// Suma uno
-         usleep( 1 );
+         Trabajo();
       }
 
    }
 
+   pthread_setaffinity_np( pthread_self(), sizeof( original ), & original );
+
    return total;
 
 }
@@ -89,18 +244,18 @@ long SerialTest( long hilos ) {
 */
 long ForkTestNoRaceCondition( long hilos ) {
    long hilo;
-   std::vector< std::thread * > trabajadores;
+   std::vector< std::thread > trabajadores;
 
    mutex = (pthread_mutex_t *) calloc( 1, sizeof( pthread_mutex_t ) );
    pthread_mutex_init( mutex, NULL );
 
+   trabajadores.reserve( hilos );
    for ( hilo = 0; hilo < hilos; hilo++ ) {
-      std::thread * nuevo  = new std::thread( AddOneWithMutex, hilo);
-      trabajadores.push_back( nuevo );
+      trabajadores.emplace_back( AddOneWithMutex, hilo );
    }
 
-   for ( auto h: trabajadores ) {
-      h->join();
+   for ( auto & h: trabajadores ) {
+      h.join();
    }
 
    pthread_mutex_destroy( mutex );
@@ -115,82 +270,310 @@ long ForkTestNoRaceCondition( long hilos ) {
 */
 long ForkTestRaceCondition( long hilos ) {
    long hilo;
-   std::vector<std::thread*> trabajadores;
+   std::vector< std::thread > trabajadores;
 
+   trabajadores.reserve( hilos );
+   for ( hilo = 0; hilo < hilos; hilo++ ) {
+      trabajadores.emplace_back( AddOne, hilo );
+   }
+
+   for ( auto & h: trabajadores ) {
+      h.join();
+   }
 
+   return total;
+
+}
+
+
+/*
+  Fork test con std::atomic
+*/
+long ForkTestAtomic( long hilos ) {
+   long hilo;
+   std::vector< std::thread > trabajadores;
+
+   totalAtomico = 0;
+
+   trabajadores.reserve( hilos );
    for ( hilo = 0; hilo < hilos; hilo++ ) {
-      std::thread * nuevo  = new std::thread( AddOne, hilo);
-      trabajadores.push_back( nuevo );
+      trabajadores.emplace_back( AddOneAtomic, hilo );
    }
 
-   for ( auto h: trabajadores ) {
-      h->join();
+   for ( auto & h: trabajadores ) {
+      h.join();
    }
 
+   total = totalAtomico;
    return total;
 
 }
 
 
 /*
- *
+  Fork test con sumas parciales en lineas de cache separadas
+*/
+long ForkTestPadded( long hilos ) {
+   long hilo;
+   std::vector< std::thread > trabajadores;
+
+   parciales = new SumaParcial[ hilos ]();
+
+   trabajadores.reserve( hilos );
+   for ( hilo = 0; hilo < hilos; hilo++ ) {
+      trabajadores.emplace_back( AddOnePadded, hilo );
+   }
+
+   for ( hilo = 0; hilo < hilos; hilo++ ) {
+      trabajadores[ hilo ].join();
+      total += parciales[ hilo ].valor;
+   }
+
+   delete [] parciales;
+
+   return total;
+
+}
+
+
+/*
+  Fork test con sumas parciales contiguas (false sharing)
+*/
+long ForkTestFalseSharing( long hilos ) {
+   long hilo;
+   std::vector< std::thread > trabajadores;
+
+   compartidas = new long[ hilos ]();
+
+   trabajadores.reserve( hilos );
+   for ( hilo = 0; hilo < hilos; hilo++ ) {
+      trabajadores.emplace_back( AddOneFalseSharing, hilo );
+   }
+
+   for ( hilo = 0; hilo < hilos; hilo++ ) {
+      trabajadores[ hilo ].join();
+      total += compartidas[ hilo ];
+   }
+
+   delete [] compartidas;
+
+   return total;
+
+}
+
+
+/*
+  Pool test: un hilo por procesador se reparte el trabajo de los "hilos"
+  pedidos; cada trabajador suma en privado y agrega su total una vez
+*/
+long PoolTest( long hilos ) {
+   unsigned procesadores = std::thread::hardware_concurrency();
+   std::atomic< long > siguiente( 0 );
+   std::vector< std::thread > trabajadores;
+
+   if ( procesadores == 0 ) {
+      procesadores = 1;
+   }
+
+   totalAtomico = 0;
+
+   for ( unsigned trabajador = 0; trabajador < procesadores; trabajador++ ) {
+      trabajadores.emplace_back( [ &, trabajador ]() {
+         long tarea, i;
+         long myTotal = 0;
+
+         Fijar( trabajador );
+         while ( ( tarea = siguiente.fetch_add( 1 ) ) < hilos ) {
+            for ( i = 0; i < iteraciones; i++ ) {
+               myTotal++;
+               Trabajo();
+            }
+         }
+
+         totalAtomico.fetch_add( myTotal );
+      } );
+   }
+
+   for ( auto & h: trabajadores ) {
+      h.join();
+   }
+
+   total = totalAtomico;
+   return total;
+
+}
+
+
+#if defined( USE_PARALLEL_STL ) && defined( __cpp_lib_parallel_algorithm )
+/*
+  Parallel STL test: reduccion con std::transform_reduce y std::execution::par
+*/
+long ParallelTest( long hilos ) {
+   std::vector< long > tareas( hilos );
+
+   std::iota( tareas.begin(), tareas.end(), 0 );
+   total = std::transform_reduce( std::execution::par, tareas.begin(), tareas.end(),
+                                  0L, std::plus< long >(), []( long ) {
+      long i;
+      long myTotal = 0;
+
+      for ( i = 0; i < iteraciones; i++ ) {
+         myTotal++;
+         Trabajo();
+      }
+
+      return myTotal;
+   } );
+
+   return total;
+
+}
+#endif
+
+
+/*
+ *  Tiempo del reloj "reloj" en ms
+ */
+double Milisegundos( clockid_t reloj ) {
+   struct timespec tiempo;
+
+   clock_gettime( reloj, & tiempo );
+   return tiempo.tv_sec * 1000.0 + tiempo.tv_nsec / 1000000.0;
+}
+
+
+/*
+ *  Contador de ciclos del procesador, 0 si no esta disponible
  */
-void startTimer( struct timeval * timerStart) {
-   gettimeofday( timerStart, NULL );
+unsigned long long Ciclos() {
+#if defined( __x86_64__ ) || defined( __i386__ )
+   return __rdtsc();
+#else
+   return 0;
+#endif
 }
 
 
 /*
- *  time elapsed in ms
+ *  Valor en la posicion "percentil" de las muestras ya ordenadas
  */
-double getTimer( struct timeval timerStart ) {
-   struct timeval timerStop, timerElapsed;
+double Percentil( const std::vector< double > & muestras, double percentil ) {
+   size_t posicion = (size_t) ( percentil * muestras.size() + 0.999999 );
 
-   gettimeofday(&timerStop, NULL);
-   timersub(&timerStop, &timerStart, &timerElapsed);
-   return timerElapsed.tv_sec*1000.0+timerElapsed.tv_usec/1000.0;
+   return muestras[ posicion > 0 ? posicion - 1 : 0 ];
 }
 
 
+/*
+ *  Corre una version "calentamiento" veces sin medir y "repeticiones" veces
+ *  midiendo, y calcula las estadisticas de las corridas medidas
+ */
+Medicion Medir( const Prueba & prueba, long hilos ) {
+   std::vector< double > wall, cpu, ciclos;
+   Medicion medicion;
+   long corrida;
 
-int main( int argc, char ** argv ) {
-   long hilos;
-   clock_t start, finish;
-   struct timeval timerStart;
-   double used, wused;
+   medicion.correcto = true;
 
+   for ( corrida = 0; corrida < calentamiento + repeticiones; corrida++ ) {
+      total = 0;
+
+      double wallInicio = Milisegundos( CLOCK_MONOTONIC );
+      double cpuInicio = Milisegundos( CLOCK_PROCESS_CPUTIME_ID );
+      unsigned long long ciclosInicio = Ciclos();
+
+      prueba.funcion( hilos );
+
+      unsigned long long ciclosFin = Ciclos();
+      double cpuFin = Milisegundos( CLOCK_PROCESS_CPUTIME_ID );
+      double wallFin = Milisegundos( CLOCK_MONOTONIC );
+
+      if ( corrida >= calentamiento ) {
+         wall.push_back( wallFin - wallInicio );
+         cpu.push_back( cpuFin - cpuInicio );
+         ciclos.push_back( (double) ( ciclosFin - ciclosInicio ) );
+         medicion.correcto = medicion.correcto && ( total == hilos * iteraciones );
+      }
+   }
+
+   std::sort( wall.begin(), wall.end() );
+   std::sort( cpu.begin(), cpu.end() );
+   std::sort( ciclos.begin(), ciclos.end() );
+
+   medicion.total = total;
+   medicion.wallMediana = Percentil( wall, 0.5 );
+   medicion.wallP99 = Percentil( wall, 0.99 );
+   medicion.wallMinimo = wall[ 0 ];
+   medicion.cpuMediana = Percentil( cpu, 0.5 );
+   medicion.ciclosMediana = Percentil( ciclos, 0.5 );
+
+   return medicion;
 
-   hilos = 100;
-   if ( argc > 1 ) {
-      hilos = atol( argv[ 1 ] );
-   }
-
-
-   startTimer( & timerStart );
-   start = clock();
-   total = 0;
-   SerialTest( hilos );
-   finish = clock();
-   used = ((double) (finish - start)) / CLOCKS_PER_SEC;
-   wused = getTimer( timerStart );
-   printf( "Serial version:      total es \033[91m %ld \033[0m con %ld hilos, CPU time %g seconds, wall time %g \n", total, hilos, used, wused );
-
-   startTimer( & timerStart );
-   start = clock();
-   total = 0;
-   ForkTestRaceCondition( hilos );
-   finish = clock();
-   used = ((double) (finish - start)) / CLOCKS_PER_SEC;
-   wused = getTimer( timerStart );
-   printf( "PThr, Race Cond.:    total es \033[91m %ld \033[0m con %ld hilos, CPU time %g seconds, wall time %g \n", total, hilos, used, wused );
-
-   startTimer( & timerStart );
-   start = clock();
-   total = 0;
-   ForkTestNoRaceCondition( hilos );
-   finish = clock();
-   used = ((double) (finish - start)) / CLOCKS_PER_SEC;
-   wused = getTimer( timerStart );
-   printf( "PThr, NO Race Cond.: total es \033[91m %ld \033[0m con %ld hilos, CPU time %g seconds. wall time %g \n", total, hilos, used, wused );
 }
 
+
+int main( int argc, char ** argv ) {
+   long hilos, cantidad;
+   bool barrido = false;
+   int opcion;
+
+   while ( ( opcion = getopt( argc, argv, "w:r:ps" ) ) != -1 ) {
+      switch ( opcion ) {
+         case 'w': calentamiento = atol( optarg ); break;
+         case 'r': repeticiones = atol( optarg ); break;
+         case 'p': fijar = true; break;
+         case 's': barrido = true; break;
+         default:  repeticiones = 0; break;
+      }
+   }
+
+   hilos = 100;
+   if ( argc > optind ) {
+      hilos = atol( argv[ optind ] );
+   }
+   if ( argc > optind + 1 ) {
+      iteraciones = atol( argv[ optind + 1 ] );
+   }
+   if ( argc > optind + 2 ) {
+      pausa = atol( argv[ optind + 2 ] );
+   }
+
+   if ( hilos <= 0 || iteraciones < 0 || pausa < 0 || calentamiento < 0 || repeticiones <= 0 ) {
+      fprintf( stderr, "Uso: %s [-w calentamiento] [-r repeticiones] [-p] [-s] "
+                       "[hilos [iteraciones [pausa]]]\n", argv[ 0 ] );
+      return 1;
+   }
+
+   const Prueba pruebas[] = {
+      { "serial", SerialTest },
+      { "race", ForkTestRaceCondition },
+      { "mutex", ForkTestNoRaceCondition },
+      { "atomic", ForkTestAtomic },
+      { "padded", ForkTestPadded },
+      { "false_sharing", ForkTestFalseSharing },
+      { "pool", PoolTest },
+#if defined( USE_PARALLEL_STL ) && defined( __cpp_lib_parallel_algorithm )
+      { "parallel_stl", ParallelTest },
+#endif
+   };
+
+   printf( "variant,threads,iterations,sleep_us,repetitions,total,expected,correct,"
+           "wall_median_ms,wall_p99_ms,wall_min_ms,cpu_median_ms,tsc_median\n" );
+
+   // Con -s se mide con 1, 2, 4, ... hilos y al final con "hilos"
+   for ( cantidad = barrido ? 1 : hilos; cantidad <= hilos;
+         cantidad = ( cantidad < hilos && cantidad * 2 > hilos ) ? hilos : cantidad * 2 ) {
+      for ( const Prueba & prueba: pruebas ) {
+         Medicion medicion = Medir( prueba, cantidad );
+
+         printf( "%s,%ld,%ld,%ld,%ld,%ld,%ld,%d,%.3f,%.3f,%.3f,%.3f,%.0f\n",
+                 prueba.nombre, cantidad, iteraciones, pausa, repeticiones,
+                 medicion.total, cantidad * iteraciones, medicion.correcto,
+                 medicion.wallMediana, medicion.wallP99, medicion.wallMinimo,
+                 medicion.cpuMediana, medicion.ciclosMediana );
+         fflush( stdout );
+      }
+   }
+
+   return 0;
+}
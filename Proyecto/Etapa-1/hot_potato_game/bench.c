@@ -0,0 +1,321 @@
+/**
+ * Medicion de la latencia de pasar la papa entre hilos.
+ */
+
+#define _GNU_SOURCE
+
+#include "bench.h"
+#include "turn.h"
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Mecanismos para pasar el turno.
+#define BENCH_SEMAPHORE 0
+#define BENCH_FLAGS     1
+
+/**
+ * Memoria compartida entre los hilos de la medicion. Los campos que no
+ * son semaforos ni banderas solo los usa el hilo que tiene la papa; pasar
+ * el turno los hace visibles para el siguiente.
+ */
+typedef struct bench_data
+{
+    size_t player_count;
+    bool rotating_right;
+    int mechanism;
+
+    // Pases de calentamiento (una vuelta), pases medidos y pase actual.
+    size_t warmup_count;
+    size_t hop_count;
+    size_t hop;
+    bool done;
+
+    // Momento en que se paso la papa por ultima vez, en nanosegundos.
+    uint64_t post_time;
+    // Latencia de cada pase medido, en nanosegundos.
+    uint64_t* latencies;
+
+    sem_t* semaphores;
+    turn_flag_t* flags;
+} bench_data_t;
+
+/**
+ * Datos privados para cada hilo de la medicion.
+ */
+typedef struct bench_player
+{
+    size_t player_id;
+    bench_data_t* bench_data;
+} bench_player_t;
+
+/**
+ * Comienza la ejecucion de un hilo de la medicion.
+ *
+ * @param data  Direccion de memoria de los datos privados del hilo.
+ */
+static void* run_bench_player(void* data);
+
+/**
+ * Mide un mecanismo y luego imprime sus resultados.
+ *
+ * @param bench_data    Memoria compartida de la medicion.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+static int measure(bench_data_t* bench_data);
+
+/**
+ * Le pasa el turno al jugador @a player_id con el mecanismo actual.
+ *
+ * @param bench_data    Memoria compartida de la medicion.
+ * @param player_id     Jugador que recibe el turno.
+ */
+static void pass_turn(bench_data_t* bench_data, size_t player_id);
+
+/**
+ * Imprime la latencia promedio y los percentiles de @a bench_data.
+ *
+ * @param bench_data    Memoria compartida de la medicion.
+ */
+static void print_latencies(bench_data_t* bench_data);
+
+/**
+ * Retorna el tiempo del reloj monotonico en nanosegundos.
+ */
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t) time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+/**
+ * Compara dos latencias para qsort.
+ */
+static int compare_latencies(const void* first, const void* second)
+{
+    uint64_t a = *(const uint64_t*) first;
+    uint64_t b = *(const uint64_t*) second;
+    return (a > b) - (a < b);
+}
+
+int run_benchmark(size_t player_count, bool rotating_right, size_t hop_count)
+{
+    int error = 0;
+
+    bench_data_t bench_data;
+    bench_data.player_count = player_count;
+    bench_data.rotating_right = rotating_right;
+    bench_data.warmup_count = player_count;
+    bench_data.hop_count = hop_count;
+    bench_data.latencies = (uint64_t*) malloc(hop_count * sizeof(uint64_t));
+    bench_data.semaphores = (sem_t*) calloc(player_count, sizeof(sem_t));
+    bench_data.flags = turn_flags_create(player_count, player_count);
+
+    if (bench_data.latencies && bench_data.semaphores && bench_data.flags)
+    {
+        printf("Players: %zu, hops: %zu\n", player_count, hop_count);
+
+        for (size_t index = 0; index < player_count; ++index)
+        {
+            sem_init(&bench_data.semaphores[index], 0, 0);
+        }
+
+        bench_data.mechanism = BENCH_SEMAPHORE;
+        error = measure(&bench_data);
+
+        if (error == 0)
+        {
+            bench_data.mechanism = BENCH_FLAGS;
+            error = measure(&bench_data);
+        }
+
+        for (size_t index = 0; index < player_count; ++index)
+        {
+            sem_destroy(&bench_data.semaphores[index]);
+        }
+    }
+    else
+    {
+        fprintf(stderr, "Error: Could not allocate memory for the benchmark.\n");
+        error = 21;
+    }
+
+    free(bench_data.flags);
+    free(bench_data.semaphores);
+    free(bench_data.latencies);
+
+    return error;
+}
+
+static int measure(bench_data_t* bench_data)
+{
+    int error = 0;
+    size_t created = 0;
+
+    bench_data->hop = 0;
+    bench_data->done = false;
+
+    pthread_t* players = (pthread_t*)
+        malloc(bench_data->player_count * sizeof(pthread_t));
+    bench_player_t* private_data = (bench_player_t*)
+        calloc(bench_data->player_count, sizeof(bench_player_t));
+
+    if (players && private_data)
+    {
+        for (size_t index = 0; index < bench_data->player_count && error == 0;
+             ++index)
+        {
+            private_data[index].player_id = index;
+            private_data[index].bench_data = bench_data;
+
+            if (pthread_create(&players[index], NULL, run_bench_player,
+                               &private_data[index]) == 0)
+            {
+                ++created;
+            }
+            else
+            {
+                fprintf(stderr, "Error: Could not create thread %zu\n", index);
+                error = 22;
+            }
+        }
+
+        // Nadie tiene la papa hasta que todos los hilos existen. Si alguno
+        // no se pudo crear, se despierta a los demas para que terminen.
+        if (error != 0)
+        {
+            bench_data->done = true;
+        }
+
+        for (size_t index = 0; index < ((error == 0) ? 1 : created); ++index)
+        {
+            pass_turn(bench_data, index);
+        }
+
+        for (size_t index = 0; index < created; ++index)
+        {
+            pthread_join(players[index], NULL);
+        }
+
+        if (error == 0)
+        {
+            print_latencies(bench_data);
+        }
+    }
+    else
+    {
+        fprintf(stderr,
+                "Error: Could not allocate memory for %zu threads.\n",
+                bench_data->player_count);
+        error = 21;
+    }
+
+    free(private_data);
+    free(players);
+
+    return error;
+}
+
+static void* run_bench_player(void* data)
+{
+    bench_player_t* private_data = (bench_player_t*) data;
+    bench_data_t* bench_data = private_data->bench_data;
+
+    size_t id = private_data->player_id;
+    size_t count = bench_data->player_count;
+    size_t next_player = bench_data->rotating_right
+        ? (id + 1) % count
+        : (id == 0) ? (count - 1) : (id - 1);
+
+    bool playing = true;
+
+    while (playing)
+    {
+        // Esperar a que sea mi turno.
+        if (bench_data->mechanism == BENCH_SEMAPHORE)
+        {
+            sem_wait(&bench_data->semaphores[id]);
+        }
+        else
+        {
+            turn_flag_wait(&bench_data->flags[id]);
+        }
+
+        uint64_t arrival = now_ns();
+
+        if (bench_data->done)
+        {
+            // Solo queda pasar la papa para que el siguiente tambien termine.
+            playing = false;
+        }
+        else
+        {
+            // El pase que acaba de llegar, contando desde 1.
+            size_t hop = bench_data->hop;
+
+            if (hop > bench_data->warmup_count)
+            {
+                bench_data->latencies[hop - bench_data->warmup_count - 1] =
+                    arrival - bench_data->post_time;
+            }
+
+            if (hop == bench_data->warmup_count + bench_data->hop_count)
+            {
+                bench_data->done = true;
+                playing = false;
+            }
+            else
+            {
+                bench_data->hop = hop + 1;
+            }
+        }
+
+        // Pasar la papa.
+        bench_data->post_time = now_ns();
+
+        pass_turn(bench_data, next_player);
+    }
+
+    return NULL;
+}
+
+static void pass_turn(bench_data_t* bench_data, size_t player_id)
+{
+    if (bench_data->mechanism == BENCH_SEMAPHORE)
+    {
+        sem_post(&bench_data->semaphores[player_id]);
+    }
+    else
+    {
+        turn_flag_post(&bench_data->flags[player_id]);
+    }
+}
+
+static void print_latencies(bench_data_t* bench_data)
+{
+    uint64_t* latencies = bench_data->latencies;
+    size_t count = bench_data->hop_count;
+    double sum = 0;
+
+    qsort(latencies, count, sizeof(uint64_t), compare_latencies);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        sum += latencies[index];
+    }
+
+    printf("%-9s mean %.0f ns, p50 %llu ns, p90 %llu ns, p99 %llu ns, "
+           "p99.9 %llu ns, max %llu ns\n",
+           (bench_data->mechanism == BENCH_SEMAPHORE) ? "semaphore" : "flags",
+           sum / count,
+           (unsigned long long) latencies[count / 2],
+           (unsigned long long) latencies[count * 90 / 100],
+           (unsigned long long) latencies[count * 99 / 100],
+           (unsigned long long) latencies[count * 999 / 1000],
+           (unsigned long long) latencies[count - 1]);
+}
@@ -0,0 +1,24 @@
+/**
+ * Medicion de la latencia de pasar la papa entre hilos.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Pasa la papa @a hop_count veces alrededor de un circulo de
+ * @a player_count hilos, sin pausas, primero con un semaforo por
+ * jugador y luego con banderas atomicas (ver turn.h), e imprime
+ * los percentiles de la latencia de cada pase.
+ *
+ * @param player_count      Numero de jugadores del circulo.
+ * @param rotating_right    Sentido de rotacion.
+ * @param hop_count         Numero de pases medidos por mecanismo.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int run_benchmark(size_t player_count, bool rotating_right, size_t hop_count);
+
+#endif /* BENCH_H */
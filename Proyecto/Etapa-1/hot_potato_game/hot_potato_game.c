@@ -2,11 +2,17 @@
  * Programa que simula el juego de la papa caliente con el uso de pthreads.
  */
 
+#include "bench.h"
+#include "pool.h"
+#include "stress.h"
+
 #include <pthread.h>
 #include <semaphore.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -18,10 +24,33 @@ typedef struct shared_data
     size_t player_count;
     int potato_id;
     bool rotating_right;
-    bool playing;
+    // Lo leen todos los hilos fuera de su turno.
+    atomic_bool playing;
+    // Pases por medir en el modo de medicion, o 0 para jugar.
+    size_t bench_hops;
+    // Si es true, los jugadores son tareas que ejecuta un grupo de
+    // pool_size hilos en lugar de tener un hilo cada uno.
+    bool use_pool;
+    size_t pool_size;
+    // Papas por juego, juegos y pases por papa de la prueba de
+    // rendimiento, o 0 papas para jugar.
+    size_t potato_count;
+    size_t game_count;
+    size_t hop_count;
 
     sem_t* player_turn;
-    bool* active_players;
+    // Circulo de los jugadores activos: cada jugador que pierde se saca
+    // del circulo y ya no recibe la papa. Solo lo modifica el jugador
+    // que tiene la papa.
+    size_t* next_players;
+    size_t* previous_players;
+    atomic_size_t active_count;
+
+    // En el modo con grupo de hilos, pasar la papa es enviar la tarea
+    // del siguiente jugador al grupo. El ganador avisa en game_over.
+    pool_t pool;
+    struct private_data* players;
+    sem_t game_over;
 } shared_data_t;
 
 /**
@@ -29,6 +58,8 @@ typedef struct shared_data
  */
 typedef struct private_data
 {
+    // Tarea del jugador en el modo con grupo de hilos.
+    pool_task_t task;
     size_t player_id;
     bool active;
     shared_data_t* shared_data;
@@ -59,6 +90,40 @@ int analyze_arguments(shared_data_t* shared_data, int argc, char* argv[]);
  */
 int create_threads(shared_data_t* shared_data);
 
+/**
+ * Crea un grupo de hilos y simula el juego con un jugador por tarea,
+ * sin pausas entre turnos.
+ * 
+ * @param shared_data   Memoria compartida de los hilos.
+ */
+int create_tasks(shared_data_t* shared_data);
+
+/**
+ * Prepara el circulo de jugadores activos y los datos privados
+ * de cada jugador.
+ * 
+ * @param shared_data   Memoria compartida de los hilos.
+ * @param private_data  Arreglo con los datos privados de cada jugador.
+ */
+void init_players(shared_data_t* shared_data, private_data_t* private_data);
+
+/**
+ * Juega el turno de un jugador que acaba de recibir la papa.
+ * 
+ * @param private_data  Datos privados del jugador.
+ * @param next_player   Recibe el jugador al que se le debe pasar la papa.
+ * @return true si el juego sigue; false si el jugador gano.
+ */
+bool play_turn(private_data_t* private_data, size_t* next_player);
+
+/**
+ * Ejecuta el turno de un jugador en el modo con grupo de hilos
+ * y envia la tarea del siguiente jugador.
+ * 
+ * @param task  Tarea del jugador.
+ */
+void run_task(pool_task_t* task);
+
 /**
  * Le aplica las reglas de Collatz al valor de la papa caliente.
  * 
@@ -67,13 +132,12 @@ int create_threads(shared_data_t* shared_data);
 int change_potato_value(int potato_value);
 
 /**
- * Verifica si en la partida quedan otros jugadores activos.
+ * Saca al jugador @a id del circulo de jugadores activos.
  * 
  * @param shared_data   Memoria compartida de los hilos.
  * @param id            Identificador del hilo que invoca a esta subrutina.
- * @return true si ya no quedan otros jugadores activos; de lo contrario false.
  */
-bool no_more_players(shared_data_t* shared_data, size_t id);
+void leave_game(shared_data_t* shared_data, size_t id);
 
 /**
  * Subrutina principal. Comienza la ejecucion del programa.
@@ -93,18 +157,43 @@ int main(int argc, char* argv[])
     {
         error = analyze_arguments(shared_data, argc, argv);
 
-        if (error == 0)
+        if (error == 0 && shared_data->bench_hops > 0)
+        {
+            error = run_benchmark(shared_data->player_count,
+                                  shared_data->rotating_right,
+                                  shared_data->bench_hops);
+            free(shared_data);
+        }
+        else if (error == 0 && shared_data->potato_count > 0)
         {
-            shared_data->playing = true;
+            stress_config_t config;
+            config.player_count = shared_data->player_count;
+            config.potato_id = shared_data->potato_id;
+            config.rotating_right = shared_data->rotating_right;
+            config.potato_count = shared_data->potato_count;
+            config.game_count = shared_data->game_count;
+            config.hop_count = shared_data->hop_count;
+            config.pool_size = shared_data->pool_size;
+
+            error = run_stress(&config);
+            free(shared_data);
+        }
+        else if (error == 0)
+        {
+            atomic_init(&shared_data->playing, true);
 
             shared_data->player_turn = (sem_t*)
                 calloc(shared_data->player_count, sizeof(sem_t));
-            shared_data->active_players = (bool*)
-                calloc(shared_data->player_count, sizeof(bool));
+            shared_data->next_players = (size_t*)
+                calloc(shared_data->player_count, sizeof(size_t));
+            shared_data->previous_players = (size_t*)
+                calloc(shared_data->player_count, sizeof(size_t));
 
-            error = create_threads(shared_data);
+            error = shared_data->use_pool ? create_tasks(shared_data)
+                                          : create_threads(shared_data);
 
-            free(shared_data->active_players);
+            free(shared_data->previous_players);
+            free(shared_data->next_players);
             free(shared_data->player_turn);
             free(shared_data);
         }
@@ -151,16 +240,105 @@ int analyze_arguments(shared_data_t* shared_data, int argc, char* argv[])
                 error = 4;
             }
         }
+
+        for (int index = 4; index < argc && error == 0; ++index)
+        {
+            if (strcmp(argv[index], "--bench") == 0)
+            {
+                if (index + 1 >= argc
+                    || sscanf(argv[index + 1], "%zu", &shared_data->bench_hops) != 1
+                    || shared_data->bench_hops == 0)
+                {
+                    fprintf(stderr, "Error: Invalid number of hops. Must be positive.\n");
+                    error = 5;
+                }
+                index += 1;
+            }
+            else if (strcmp(argv[index], "--pool") == 0)
+            {
+                shared_data->use_pool = true;
+                if (shared_data->pool_size == 0)
+                {
+                    shared_data->pool_size = pool_default_size();
+                }
+            }
+            else if (strcmp(argv[index], "--workers") == 0)
+            {
+                if (index + 1 >= argc
+                    || sscanf(argv[index + 1], "%zu", &shared_data->pool_size) != 1
+                    || shared_data->pool_size == 0)
+                {
+                    fprintf(stderr, "Error: Invalid number of workers. Must be positive.\n");
+                    error = 6;
+                }
+                shared_data->use_pool = true;
+                index += 1;
+            }
+            else if (strcmp(argv[index], "--potatoes") == 0
+                     || strcmp(argv[index], "--games") == 0
+                     || strcmp(argv[index], "--hops") == 0)
+            {
+                size_t value = 0;
+
+                if (index + 1 >= argc
+                    || sscanf(argv[index + 1], "%zu", &value) != 1 || value == 0)
+                {
+                    fprintf(stderr, "Error: Invalid value for %s. Must be positive.\n",
+                            argv[index]);
+                    error = 7;
+                }
+                else if (strcmp(argv[index], "--potatoes") == 0)
+                {
+                    shared_data->potato_count = value;
+                }
+                else if (strcmp(argv[index], "--games") == 0)
+                {
+                    shared_data->game_count = value;
+                }
+                else
+                {
+                    shared_data->hop_count = value;
+                }
+                index += 1;
+            }
+            else
+            {
+                fprintf(stderr, "Error: Unknown option %s\n", argv[index]);
+                error = 1;
+            }
+        }
     }
     else
     {
         fprintf(stderr, "Usage: hot_potato_game player_count "
-                        "initial_potato_id direction\n"
+                        "initial_potato_id direction [options]\n"
                         "direction: 0 to rotate to left, "
-                        "1 or any other number to rotate to right\n");
+                        "1 or any other number to rotate to right\n"
+                        "options:\n"
+                        "\t--bench hops\n"
+                        "\t--pool\n"
+                        "\t--workers count\n"
+                        "\t--potatoes count\n"
+                        "\t--games count\n"
+                        "\t--hops count\n");
         error = 1;
     }
 
+    // Valores por omision de la prueba de rendimiento. Basta con pedir
+    // varios juegos o un numero de pases para hacerla con una papa.
+    if (shared_data->game_count > 0 || shared_data->hop_count > 0)
+    {
+        shared_data->potato_count += (shared_data->potato_count == 0);
+    }
+    if (shared_data->potato_count > 0)
+    {
+        shared_data->game_count += (shared_data->game_count == 0);
+        shared_data->hop_count = (shared_data->hop_count == 0)
+            ? 100000 : shared_data->hop_count;
+        shared_data->pool_size = (shared_data->pool_size == 0)
+            ? pool_default_size() : shared_data->pool_size;
+    }
+
     return error;
 }
 
@@ -174,18 +352,19 @@ int create_threads(shared_data_t* shared_data)
     private_data_t* private_data = (private_data_t*)
         calloc(shared_data->player_count, sizeof(private_data_t));
 
-    if (players && private_data)
+    if (players && private_data && shared_data->player_turn
+        && shared_data->next_players && shared_data->previous_players)
     {
+        init_players(shared_data, private_data);
+
         for (size_t index = 0; index < shared_data->player_count; ++index)
         {
             // Todos los semaforos empiezan bloqueados, excepto el 0.
             sem_init(&shared_data->player_turn[index], 0, !(index));
-            shared_data->active_players[index] = true;
-
-            private_data[index].player_id = index;
-            private_data[index].active = true;
-            private_data[index].shared_data = shared_data;
+        }
 
+        for (size_t index = 0; index < shared_data->player_count; ++index)
+        {
             error = pthread_create(&players[index], NULL, run, &private_data[index]);
 
             if (error != 0)
@@ -220,61 +399,17 @@ void* run(void* data)
     private_data_t* private_data = (private_data_t*) data;
     shared_data_t* shared_data = private_data->shared_data;
 
-    // Mientras el juego no haya terminado
-    while (shared_data->playing)
+    size_t next_player = 0;
+
+    // Mientras el juego no haya terminado y yo siga en el circulo
+    while (atomic_load(&shared_data->playing) && private_data->active)
     {
         // Esperar a que sea mi turno.
         sem_wait(&shared_data->player_turn[ private_data->player_id ]);
 
-        if (private_data->active)
+        if (!play_turn(private_data, &next_player))
         {
-            // Si ya no quedan otros jugadores activos, gano yo.
-            if (no_more_players(shared_data, private_data->player_id))
-            {
-                printf("Thread #%zu won the game! No more players left.\n",
-                       private_data->player_id);
-
-                shared_data->playing = false;
-            }
-            else
-            {
-                shared_data->potato_id = change_potato_value(shared_data->potato_id);
-
-                // Si el valor de la papa me queda en 1, pierdo.
-                if (shared_data->potato_id == 1)
-                {
-                    shared_data->potato_id = rand() % 200;
-                    printf("The potato has exploded! "
-                        "Thread #%zu sets potato's value to %d and leaves the game.\n",
-                        private_data->player_id,
-                        shared_data->potato_id);
-                    
-                    private_data->active = false;
-                    shared_data->active_players[ private_data->player_id ] = false;
-                }
-            }
-        }
-
-        size_t next_player = 0;
-        
-        if (shared_data->rotating_right)
-        {
-            next_player = (private_data->player_id + 1) % shared_data->player_count;
-        }
-        else
-        {
-            next_player = (private_data->player_id == 0)
-                ? (shared_data->player_count - 1)
-                : (private_data->player_id - 1);
-        }
-
-        if (shared_data->playing)
-        {
-            printf("Thread #%zu (%s) has the potato with value %d. Next player: #%zu.\n",
-                   private_data->player_id,
-                   (private_data->active) ? "active" : "passive",
-                   shared_data->potato_id,
-                   next_player);
+            break;
         }
 
         sleep(2);
@@ -285,21 +420,140 @@ void* run(void* data)
     return NULL;
 }
 
-bool no_more_players(shared_data_t* shared_data, size_t id)
+int create_tasks(shared_data_t* shared_data)
 {
-    for (size_t index = 0; index < shared_data->player_count; ++index)
+    int error = 0;
+
+    shared_data->players = (private_data_t*)
+        calloc(shared_data->player_count, sizeof(private_data_t));
+
+    if (shared_data->players && shared_data->next_players
+        && shared_data->previous_players)
     {
-        // Si encuentro un jugador activo y no soy yo
-        if (shared_data->active_players[index] == true && index != id)
+        init_players(shared_data, shared_data->players);
+        sem_init(&shared_data->game_over, 0, 0);
+
+        error = pool_create(&shared_data->pool, shared_data->pool_size);
+
+        if (error == 0)
         {
-            // Aun quedan otros jugadores activos.
-            return false;
+            // El jugador 0 empieza con la papa.
+            pool_submit(&shared_data->pool, &shared_data->players[0].task);
+            sem_wait(&shared_data->game_over);
+            pool_destroy(&shared_data->pool);
         }
+
+        sem_destroy(&shared_data->game_over);
+    }
+    else
+    {
+        fprintf(stderr,
+                "Error: Could not allocate memory for %zu players.\n",
+                shared_data->player_count);
+        error = 21;
+    }
+
+    free(shared_data->players);
+
+    return error;
+}
+
+void init_players(shared_data_t* shared_data, private_data_t* private_data)
+{
+    size_t count = shared_data->player_count;
+    atomic_init(&shared_data->active_count, count);
+
+    // Todos los jugadores deben estar activos antes de que el
+    // primero reciba la papa.
+    for (size_t index = 0; index < count; ++index)
+    {
+        // El siguiente en el sentido de rotacion y el anterior.
+        size_t right = (index + 1) % count;
+        size_t left = (index == 0) ? (count - 1) : (index - 1);
+        shared_data->next_players[index] =
+            shared_data->rotating_right ? right : left;
+        shared_data->previous_players[index] =
+            shared_data->rotating_right ? left : right;
+
+        private_data[index].task.run = run_task;
+        private_data[index].player_id = index;
+        private_data[index].active = true;
+        private_data[index].shared_data = shared_data;
     }
+}
+
+bool play_turn(private_data_t* private_data, size_t* next_player)
+{
+    shared_data_t* shared_data = private_data->shared_data;
+
+    // Si ya no quedan otros jugadores activos, gano yo.
+    if (atomic_load(&shared_data->active_count) == 1)
+    {
+        printf("Thread #%zu won the game! No more players left.\n",
+               private_data->player_id);
+
+        atomic_store(&shared_data->playing, false);
+        return false;
+    }
+
+    shared_data->potato_id = change_potato_value(shared_data->potato_id);
+
+    // Si el valor de la papa me queda en 1, pierdo.
+    if (shared_data->potato_id == 1)
+    {
+        // Igual que el valor inicial, el nuevo valor debe ser mayor que 1;
+        // con 0 la papa nunca explotaria.
+        shared_data->potato_id = rand() % 198 + 2;
+        printf("The potato has exploded! "
+            "Thread #%zu sets potato's value to %d and leaves the game.\n",
+            private_data->player_id,
+            shared_data->potato_id);
+
+        private_data->active = false;
+        leave_game(shared_data, private_data->player_id);
+    }
+
+    // Los jugadores que perdieron ya no estan en el circulo.
+    *next_player = shared_data->next_players[ private_data->player_id ];
+
+    printf("Thread #%zu (%s) has the potato with value %d. Next player: #%zu.\n",
+           private_data->player_id,
+           (private_data->active) ? "active" : "passive",
+           shared_data->potato_id,
+           *next_player);
 
     return true;
 }
 
+void run_task(pool_task_t* task)
+{
+    // La tarea es el primer campo de los datos privados del jugador.
+    private_data_t* private_data = (private_data_t*) task;
+    shared_data_t* shared_data = private_data->shared_data;
+    size_t next_player = 0;
+
+    if (play_turn(private_data, &next_player))
+    {
+        // Pasar la papa.
+        pool_submit(&shared_data->pool, &shared_data->players[next_player].task);
+    }
+    else
+    {
+        sem_post(&shared_data->game_over);
+    }
+}
+
+void leave_game(shared_data_t* shared_data, size_t id)
+{
+    size_t next = shared_data->next_players[id];
+    size_t previous = shared_data->previous_players[id];
+
+    shared_data->next_players[previous] = next;
+    shared_data->previous_players[next] = previous;
+
+    atomic_fetch_sub(&shared_data->active_count, 1);
+}
+
 int change_potato_value(int potato_value)
 {
     return ( (potato_value % 2 == 0) ? potato_value / 2 : potato_value * 3 + 1 );
@@ -0,0 +1,138 @@
+/**
+ * Grupo fijo de hilos trabajadores que ejecutan tareas.
+ */
+
+#define _GNU_SOURCE
+
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * Ciclo de cada hilo trabajador: saca tareas de la cola y las ejecuta
+ * hasta que el grupo se detenga.
+ *
+ * @param data  Direccion de memoria del grupo.
+ */
+static void* run_worker(void* data)
+{
+    pool_t* pool = (pool_t*) data;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (!(pool->stopping))
+    {
+        if (pool->head == NULL)
+        {
+            pthread_cond_wait(&pool->task_ready, &pool->mutex);
+        }
+        else
+        {
+            pool_task_t* task = pool->head;
+            pool->head = task->next;
+            if (pool->head == NULL)
+            {
+                pool->tail = NULL;
+            }
+
+            pthread_mutex_unlock(&pool->mutex);
+            task->run(task);
+            pthread_mutex_lock(&pool->mutex);
+        }
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+
+int pool_create(pool_t* pool, size_t worker_count)
+{
+    int error = 0;
+
+    pool->worker_count = 0;
+    pool->head = NULL;
+    pool->tail = NULL;
+    pool->stopping = false;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->task_ready, NULL);
+
+    pool->workers = (pthread_t*) malloc(worker_count * sizeof(pthread_t));
+
+    if (pool->workers)
+    {
+        for (size_t index = 0; index < worker_count && error == 0; ++index)
+        {
+            if (pthread_create(&pool->workers[index], NULL, run_worker, pool) == 0)
+            {
+                ++pool->worker_count;
+            }
+            else
+            {
+                fprintf(stderr, "Error: Could not create worker thread %zu\n", index);
+                error = 22;
+            }
+        }
+
+        if (error != 0)
+        {
+            pool_destroy(pool);
+        }
+    }
+    else
+    {
+        fprintf(stderr,
+                "Error: Could not allocate memory for %zu worker threads.\n",
+                worker_count);
+        error = 21;
+        pthread_cond_destroy(&pool->task_ready);
+        pthread_mutex_destroy(&pool->mutex);
+    }
+
+    return error;
+}
+
+void pool_submit(pool_t* pool, pool_task_t* task)
+{
+    task->next = NULL;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    if (pool->tail == NULL)
+    {
+        pool->head = task;
+    }
+    else
+    {
+        pool->tail->next = task;
+    }
+    pool->tail = task;
+
+    pthread_cond_signal(&pool->task_ready);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void pool_destroy(pool_t* pool)
+{
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->task_ready);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (size_t index = 0; index < pool->worker_count; ++index)
+    {
+        pthread_join(pool->workers[index], NULL);
+    }
+
+    free(pool->workers);
+    pthread_cond_destroy(&pool->task_ready);
+    pthread_mutex_destroy(&pool->mutex);
+}
+
+size_t pool_default_size(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (size_t) count : 1;
+}
@@ -0,0 +1,72 @@
+/**
+ * Grupo fijo de hilos trabajadores que ejecutan tareas.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Tarea que ejecuta el grupo de hilos. Se incluye dentro de los datos
+ * de quien la envia (por ejemplo, un jugador), de modo que enviar una
+ * tarea no reserva memoria.
+ */
+typedef struct pool_task
+{
+    // Subrutina que ejecuta la tarea. Recibe la misma tarea.
+    void (*run)(struct pool_task* task);
+    // Siguiente tarea en la cola.
+    struct pool_task* next;
+} pool_task_t;
+
+/**
+ * Grupo de hilos con una cola FIFO de tareas pendientes.
+ */
+typedef struct pool
+{
+    pthread_t* workers;
+    size_t worker_count;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t task_ready;
+    pool_task_t* head;
+    pool_task_t* tail;
+    bool stopping;
+} pool_t;
+
+/**
+ * Crea @a worker_count hilos trabajadores que esperan tareas.
+ *
+ * @param pool          Grupo por inicializar.
+ * @param worker_count  Numero de hilos trabajadores.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int pool_create(pool_t* pool, size_t worker_count);
+
+/**
+ * Agrega @a task al final de la cola y despierta a un trabajador.
+ * La tarea no debe estar ya en la cola.
+ *
+ * @param pool  Grupo que ejecuta la tarea.
+ * @param task  Tarea por ejecutar.
+ */
+void pool_submit(pool_t* pool, pool_task_t* task);
+
+/**
+ * Espera a que los trabajadores terminen las tareas que estan ejecutando,
+ * los detiene y libera los recursos del grupo. Las tareas que queden en
+ * la cola no se ejecutan.
+ *
+ * @param pool  Grupo por detener.
+ */
+void pool_destroy(pool_t* pool);
+
+/**
+ * Retorna el numero de procesadores disponibles, o 1 si no se conoce.
+ */
+size_t pool_default_size(void);
+
+#endif /* POOL_H */
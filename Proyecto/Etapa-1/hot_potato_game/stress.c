@@ -0,0 +1,276 @@
+/**
+ * Prueba de rendimiento con varias papas y varios juegos a la vez.
+ */
+
+#define _GNU_SOURCE
+
+#include "stress.h"
+#include "pool.h"
+
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * Le aplica las reglas de Collatz al valor de la papa caliente.
+ * Se define en hot_potato_game.c.
+ */
+int change_potato_value(int potato_value);
+
+/**
+ * Memoria compartida de la prueba.
+ */
+typedef struct stress_data
+{
+    stress_config_t* config;
+    pool_t pool;
+
+    // Pases que recibio cada jugador de cada juego. Varias papas pueden
+    // llegarle al mismo jugador a la vez.
+    atomic_size_t* receive_counts;
+    atomic_size_t explosion_count;
+
+    // Papas que ya dieron todos sus pases; la ultima avisa en done.
+    atomic_size_t finished_count;
+    sem_t done;
+
+    uint64_t start_time;
+} stress_data_t;
+
+/**
+ * Una papa que circula en un juego. Su tarea es el primer campo, de
+ * modo que pasar la papa es enviar su tarea al grupo de hilos.
+ */
+typedef struct potato
+{
+    pool_task_t task;
+    stress_data_t* stress_data;
+
+    size_t game;
+    size_t holder;
+    int value;
+    // Estado del generador de numeros aleatorios de la papa.
+    uint32_t random_state;
+
+    size_t hop;
+    // Momento en que la papa dio su ultimo pase, en nanosegundos.
+    uint64_t finish_time;
+} potato_t;
+
+/**
+ * Ejecuta un pase de la papa: el jugador que la tiene cambia su valor
+ * y se la pasa al siguiente.
+ *
+ * @param task  Tarea de la papa.
+ */
+static void run_potato(pool_task_t* task);
+
+/**
+ * Imprime el rendimiento y la equidad de la prueba.
+ *
+ * @param stress_data   Memoria compartida de la prueba.
+ * @param potatoes      Arreglo con todas las papas.
+ */
+static void print_stress_results(stress_data_t* stress_data, potato_t* potatoes);
+
+/**
+ * Retorna el tiempo del reloj monotonico en nanosegundos.
+ */
+static uint64_t now_ns(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (uint64_t) time.tv_sec * 1000000000ULL + time.tv_nsec;
+}
+
+/**
+ * Retorna el siguiente numero aleatorio de @a state (xorshift32).
+ * Cada papa tiene su estado porque rand no es seguro entre hilos.
+ */
+static uint32_t next_random(uint32_t* state)
+{
+    uint32_t value = *state;
+    value ^= value << 13;
+    value ^= value >> 17;
+    value ^= value << 5;
+    *state = value;
+    return value;
+}
+
+int run_stress(stress_config_t* config)
+{
+    int error = 0;
+
+    size_t player_total = config->game_count * config->player_count;
+    size_t potato_total = config->game_count * config->potato_count;
+
+    stress_data_t stress_data;
+    stress_data.config = config;
+    stress_data.receive_counts = (atomic_size_t*)
+        calloc(player_total, sizeof(atomic_size_t));
+    atomic_init(&stress_data.explosion_count, 0);
+    atomic_init(&stress_data.finished_count, 0);
+
+    potato_t* potatoes = (potato_t*) calloc(potato_total, sizeof(potato_t));
+
+    if (stress_data.receive_counts && potatoes)
+    {
+        for (size_t index = 0; index < player_total; ++index)
+        {
+            atomic_init(&stress_data.receive_counts[index], 0);
+        }
+
+        for (size_t index = 0; index < potato_total; ++index)
+        {
+            // Las papas de cada juego empiezan repartidas en el circulo.
+            size_t number = index % config->potato_count;
+
+            potatoes[index].task.run = run_potato;
+            potatoes[index].stress_data = &stress_data;
+            potatoes[index].game = index / config->potato_count;
+            potatoes[index].holder =
+                number * config->player_count / config->potato_count;
+            potatoes[index].value = config->potato_id + (int) number;
+            potatoes[index].random_state = (uint32_t) rand() | 1;
+        }
+
+        sem_init(&stress_data.done, 0, 0);
+        error = pool_create(&stress_data.pool, config->pool_size);
+
+        if (error == 0)
+        {
+            stress_data.start_time = now_ns();
+
+            for (size_t index = 0; index < potato_total; ++index)
+            {
+                pool_submit(&stress_data.pool, &potatoes[index].task);
+            }
+
+            sem_wait(&stress_data.done);
+            pool_destroy(&stress_data.pool);
+
+            print_stress_results(&stress_data, potatoes);
+        }
+
+        sem_destroy(&stress_data.done);
+    }
+    else
+    {
+        fprintf(stderr, "Error: Could not allocate memory for %zu players "
+                        "and %zu potatoes.\n", player_total, potato_total);
+        error = 21;
+    }
+
+    free(potatoes);
+    free(stress_data.receive_counts);
+
+    return error;
+}
+
+static void run_potato(pool_task_t* task)
+{
+    potato_t* potato = (potato_t*) task;
+    stress_data_t* stress_data = potato->stress_data;
+    stress_config_t* config = stress_data->config;
+
+    atomic_fetch_add_explicit(&stress_data->receive_counts[
+        potato->game * config->player_count + potato->holder], 1,
+        memory_order_relaxed);
+
+    potato->value = change_potato_value(potato->value);
+
+    if (potato->value == 1)
+    {
+        potato->value = next_random(&potato->random_state) % 198 + 2;
+        atomic_fetch_add_explicit(&stress_data->explosion_count, 1,
+                                  memory_order_relaxed);
+    }
+
+    // Pasar la papa.
+    if (config->rotating_right)
+    {
+        potato->holder = (potato->holder + 1) % config->player_count;
+    }
+    else
+    {
+        potato->holder = (potato->holder == 0)
+            ? (config->player_count - 1) : (potato->holder - 1);
+    }
+
+    if (++potato->hop < config->hop_count)
+    {
+        pool_submit(&stress_data->pool, &potato->task);
+    }
+    else
+    {
+        potato->finish_time = now_ns();
+
+        if (atomic_fetch_add(&stress_data->finished_count, 1) + 1
+            == config->game_count * config->potato_count)
+        {
+            sem_post(&stress_data->done);
+        }
+    }
+}
+
+static void print_stress_results(stress_data_t* stress_data, potato_t* potatoes)
+{
+    stress_config_t* config = stress_data->config;
+    size_t player_total = config->game_count * config->player_count;
+    size_t potato_total = config->game_count * config->potato_count;
+    size_t handoffs = potato_total * config->hop_count;
+
+    uint64_t end_time = stress_data->start_time;
+    uint64_t first_finish = UINT64_MAX;
+
+    // Indice de Jain de la tasa de pases de cada papa.
+    double rate_sum = 0;
+    double rate_squares = 0;
+
+    for (size_t index = 0; index < potato_total; ++index)
+    {
+        uint64_t finish = potatoes[index].finish_time;
+        double rate = config->hop_count / (double) (finish - stress_data->start_time);
+
+        end_time = (finish > end_time) ? finish : end_time;
+        first_finish = (finish < first_finish) ? finish : first_finish;
+        rate_sum += rate;
+        rate_squares += rate * rate;
+    }
+
+    // Indice de Jain de los pases que recibio cada jugador.
+    size_t min_count = SIZE_MAX;
+    size_t max_count = 0;
+    double count_sum = 0;
+    double count_squares = 0;
+
+    for (size_t index = 0; index < player_total; ++index)
+    {
+        size_t count = atomic_load(&stress_data->receive_counts[index]);
+
+        min_count = (count < min_count) ? count : min_count;
+        max_count = (count > max_count) ? count : max_count;
+        count_sum += count;
+        count_squares += (double) count * count;
+    }
+
+    double seconds = (end_time - stress_data->start_time) / 1e9;
+
+    printf("Games: %zu, players per game: %zu, potatoes per game: %zu, "
+           "workers: %zu\n", config->game_count, config->player_count,
+           config->potato_count, config->pool_size);
+    printf("Handoffs: %zu in %.3f s (%.0f handoffs/s)\n",
+           handoffs, seconds, handoffs / seconds);
+    printf("Explosions: %zu\n", atomic_load(&stress_data->explosion_count));
+    printf("Handoffs per player: min %zu, max %zu, mean %.1f, "
+           "Jain fairness %.4f\n", min_count, max_count,
+           count_sum / player_total,
+           count_sum * count_sum / (player_total * count_squares));
+    printf("Potato finish time: first %.3f s, last %.3f s, "
+           "Jain fairness of potato rates %.4f\n",
+           (first_finish - stress_data->start_time) / 1e9, seconds,
+           rate_sum * rate_sum / (potato_total * rate_squares));
+}
@@ -0,0 +1,42 @@
+/**
+ * Prueba de rendimiento con varias papas y varios juegos a la vez.
+ */
+
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Parametros de la prueba de rendimiento.
+ */
+typedef struct stress_config
+{
+    size_t player_count;
+    int potato_id;
+    bool rotating_right;
+    // Papas que circulan a la vez en cada juego.
+    size_t potato_count;
+    // Juegos independientes, cada uno con su propio circulo.
+    size_t game_count;
+    // Pases que da cada papa.
+    size_t hop_count;
+    // Hilos del grupo que ejecuta los pases.
+    size_t pool_size;
+} stress_config_t;
+
+/**
+ * Hace circular @a potato_count papas en cada uno de @a game_count
+ * circulos de jugadores, con un grupo de hilos que ejecuta cada pase
+ * como una tarea. Cada papa lleva su propio valor y le aplica las
+ * reglas de Collatz en cada pase; cuando explota toma un valor nuevo
+ * y nadie sale del juego. No se imprime nada por pase: al final se
+ * imprimen el rendimiento total y la equidad entre jugadores y papas.
+ *
+ * @param config    Parametros de la prueba.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int run_stress(stress_config_t* config);
+
+#endif /* STRESS_H */
@@ -0,0 +1,85 @@
+/**
+ * Paso del turno entre hilos con banderas atomicas.
+ */
+
+#define _GNU_SOURCE
+
+#include "turn.h"
+
+#include <linux/futex.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Veces que se consulta la bandera antes de dormir. Con un solo
+// procesador no se espera activamente, porque quien pasa el turno
+// no puede correr mientras el que espera ocupa el procesador.
+static int spin_limit = TURN_SPIN_LIMIT;
+
+/**
+ * Le indica al procesador que el hilo esta esperando activamente.
+ */
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __asm__ __volatile__("pause");
+#endif
+}
+
+turn_flag_t* turn_flags_create(size_t count, size_t first)
+{
+    turn_flag_t* flags = (turn_flag_t*)
+        aligned_alloc(CACHE_LINE_SIZE, count * sizeof(turn_flag_t));
+
+    spin_limit = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? TURN_SPIN_LIMIT : 0;
+
+    if (flags)
+    {
+        for (size_t index = 0; index < count; ++index)
+        {
+            atomic_init(&flags[index].state,
+                        (index == first) ? TURN_READY : TURN_EMPTY);
+        }
+    }
+
+    return flags;
+}
+
+void turn_flag_wait(turn_flag_t* flag)
+{
+    for (int spin = 0; spin < spin_limit; ++spin)
+    {
+        if (atomic_load_explicit(&flag->state, memory_order_acquire) == TURN_READY)
+        {
+            atomic_store_explicit(&flag->state, TURN_EMPTY, memory_order_relaxed);
+            return;
+        }
+        cpu_relax();
+    }
+
+    unsigned int expected = TURN_EMPTY;
+
+    // Avisar que se va a dormir, a menos que el turno ya haya llegado.
+    if (atomic_compare_exchange_strong_explicit(&flag->state, &expected,
+            TURN_SLEEPING, memory_order_acquire, memory_order_acquire))
+    {
+        do
+        {
+            syscall(SYS_futex, &flag->state, FUTEX_WAIT_PRIVATE, TURN_SLEEPING,
+                    NULL, NULL, 0);
+        }
+        while (atomic_load_explicit(&flag->state, memory_order_acquire)
+               != TURN_READY);
+    }
+
+    atomic_store_explicit(&flag->state, TURN_EMPTY, memory_order_relaxed);
+}
+
+void turn_flag_post(turn_flag_t* flag)
+{
+    if (atomic_exchange_explicit(&flag->state, TURN_READY, memory_order_release)
+        == TURN_SLEEPING)
+    {
+        syscall(SYS_futex, &flag->state, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * Paso del turno entre hilos con banderas atomicas.
+ */
+
+#ifndef TURN_H
+#define TURN_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Tamano de una linea de cache. Cada bandera ocupa una linea completa
+// para que los jugadores vecinos no compartan lineas (false sharing).
+#define CACHE_LINE_SIZE 64
+
+// Estados de una bandera de turno.
+#define TURN_EMPTY      0
+#define TURN_READY      1
+#define TURN_SLEEPING   2
+
+// Veces que se consulta la bandera antes de dormir en el futex,
+// si hay mas de un procesador.
+#define TURN_SPIN_LIMIT 2000
+
+/**
+ * Bandera que indica si un jugador tiene el turno. Quien pasa el turno
+ * la pone en TURN_READY con orden release y quien lo espera la lee con
+ * orden acquire, de modo que todo lo escrito antes de pasar el turno es
+ * visible para el siguiente jugador. El jugador que se cansa de esperar
+ * la pone en TURN_SLEEPING y duerme en un futex sobre ella.
+ */
+typedef struct turn_flag
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_uint state;
+    char padding[CACHE_LINE_SIZE - sizeof(atomic_uint)];
+} turn_flag_t;
+
+/**
+ * Reserva @a count banderas alineadas a la linea de cache. Solo la
+ * bandera @a first empieza con el turno.
+ *
+ * @param count     Numero de banderas.
+ * @param first     Bandera que empieza con el turno, o @a count para
+ * que ninguna lo tenga.
+ * @return Las banderas, o NULL si no hay memoria. Se liberan con free.
+ */
+turn_flag_t* turn_flags_create(size_t count, size_t first);
+
+/**
+ * Espera a que @a flag tenga el turno y lo toma. Primero consulta
+ * la bandera TURN_SPIN_LIMIT veces (si hay mas de un procesador)
+ * y luego duerme en el futex.
+ *
+ * @param flag  Bandera del jugador que espera.
+ */
+void turn_flag_wait(turn_flag_t* flag);
+
+/**
+ * Pasa el turno a @a flag y despierta a su jugador si estaba dormido.
+ *
+ * @param flag  Bandera del jugador que recibe el turno.
+ */
+void turn_flag_post(turn_flag_t* flag);
+
+#endif /* TURN_H */
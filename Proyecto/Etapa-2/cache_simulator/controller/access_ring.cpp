@@ -0,0 +1,215 @@
+/**
+ * Codigo fuente de la clase AccessRing.
+ */
+
+#include "../model/access_ring.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Identifica un anillo valido en la memoria compartida.
+#define ACCESS_RING_MAGIC 0x52494e47
+
+// Intentos de espera activa antes de ceder el procesador.
+#define RING_SPIN_LIMIT 64
+
+AccessRing::AccessRing(void* memory, std::size_t mapped_bytes,
+                       const char* owned_name) :
+    header(static_cast<RingHeader*>(memory)),
+    records(reinterpret_cast<AccessRecord*>(
+        static_cast<char*>(memory) + sizeof(RingHeader))),
+    mask(header->capacity - 1),
+    mapped_bytes(mapped_bytes),
+    owned_name(owned_name ? strdup(owned_name) : nullptr),
+    cached_head(0),
+    cached_tail(0)
+{
+}
+
+AccessRing* AccessRing::create(const char* name, std::size_t capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+        return nullptr;
+    }
+
+    int descriptor = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+
+    if (descriptor < 0)
+    {
+        return nullptr;
+    }
+
+    std::size_t bytes = sizeof(RingHeader) + capacity * sizeof(AccessRecord);
+    void* memory = MAP_FAILED;
+
+    if (ftruncate(descriptor, bytes) == 0)
+    {
+        memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      descriptor, 0);
+    }
+    ::close(descriptor);
+
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(name);
+        return nullptr;
+    }
+
+    RingHeader* header = new (memory) RingHeader;
+    header->capacity = capacity;
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->closed.store(false, std::memory_order_relaxed);
+    // El productor solo usa el anillo despues de ver el numero magico.
+    header->magic.store(ACCESS_RING_MAGIC, std::memory_order_release);
+
+    return new AccessRing(memory, bytes, name);
+}
+
+AccessRing* AccessRing::attach(const char* name)
+{
+    int descriptor = shm_open(name, O_RDWR, 0600);
+
+    if (descriptor < 0)
+    {
+        return nullptr;
+    }
+
+    AccessRing* ring = nullptr;
+    void* memory = MAP_FAILED;
+    struct stat status;
+
+    // Entre shm_open y ftruncate en create() el objeto aun no tiene
+    // tamano, y leer el encabezado causaria SIGBUS.
+    if (fstat(descriptor, &status) == 0
+        && (std::size_t) status.st_size >= sizeof(RingHeader))
+    {
+        memory = mmap(nullptr, sizeof(RingHeader), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, descriptor, 0);
+    }
+
+    if (memory != MAP_FAILED)
+    {
+        RingHeader* header = static_cast<RingHeader*>(memory);
+        std::size_t bytes = 0;
+
+        if (header->magic.load(std::memory_order_acquire) == ACCESS_RING_MAGIC)
+        {
+            bytes = sizeof(RingHeader) + header->capacity * sizeof(AccessRecord);
+        }
+        munmap(memory, sizeof(RingHeader));
+
+        if (bytes > (std::size_t) status.st_size)
+        {
+            bytes = 0;
+        }
+
+        if (bytes > 0)
+        {
+            memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          descriptor, 0);
+
+            if (memory != MAP_FAILED)
+            {
+                ring = new AccessRing(memory, bytes, nullptr);
+                ring->cached_tail = ring->header->tail.load(std::memory_order_acquire);
+                ring->cached_head = ring->header->head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    ::close(descriptor);
+
+    return ring;
+}
+
+AccessRing::~AccessRing()
+{
+    munmap(this->header, this->mapped_bytes);
+
+    if (this->owned_name != nullptr)
+    {
+        shm_unlink(this->owned_name);
+        free(this->owned_name);
+    }
+}
+
+void AccessRing::push(const Access* accesses, std::size_t count)
+{
+    std::size_t head = this->cached_head;
+    std::size_t capacity = this->mask + 1;
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        // Contrapresion: esperar a que el consumidor libere espacio.
+        for (unsigned spins = 0; head - this->cached_tail == capacity; ++spins)
+        {
+            if (spins >= RING_SPIN_LIMIT)
+            {
+                // Publicar lo escrito antes de ceder el procesador.
+                this->header->head.store(head, std::memory_order_release);
+                sched_yield();
+            }
+            this->cached_tail = this->header->tail.load(std::memory_order_acquire);
+        }
+
+        AccessRecord& record = this->records[head & this->mask];
+        record.address = accesses[index].address;
+        record.operation = accesses[index].operation;
+        record.tenant = accesses[index].tenant;
+        ++head;
+    }
+
+    this->cached_head = head;
+    this->header->head.store(head, std::memory_order_release);
+}
+
+std::size_t AccessRing::pop(Access* accesses, std::size_t max_count)
+{
+    std::size_t tail = this->cached_tail;
+
+    if (this->cached_head == tail)
+    {
+        this->cached_head = this->header->head.load(std::memory_order_acquire);
+    }
+
+    std::size_t count = this->cached_head - tail;
+    if (count > max_count)
+    {
+        count = max_count;
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+        const AccessRecord& record = this->records[(tail + index) & this->mask];
+        accesses[index].operation = record.operation;
+        accesses[index].tenant = record.tenant;
+        accesses[index].has_value = false;
+        accesses[index].value = 0;
+        accesses[index].address = record.address;
+    }
+
+    if (count > 0)
+    {
+        this->cached_tail = tail + count;
+        this->header->tail.store(this->cached_tail, std::memory_order_release);
+    }
+
+    return count;
+}
+
+void AccessRing::close()
+{
+    this->header->closed.store(true, std::memory_order_release);
+}
+
+bool AccessRing::is_closed()
+{
+    return this->header->closed.load(std::memory_order_acquire);
+}
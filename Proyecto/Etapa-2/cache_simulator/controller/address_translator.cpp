@@ -0,0 +1,215 @@
+/**
+ * Codigo fuente de la clase AddressTranslator.
+ */
+
+#include "../model/address_translator.h"
+#include "../model/cache.h"
+
+#include <cmath>
+
+// Constante impar para dispersar las paginas en RANDOM_MAPPING.
+// Multiplicar por un impar modulo 2^n es una biyeccion.
+#define PAGE_SCATTER_FACTOR 0x9e3779b1
+
+AddressTranslator::AddressTranslator(CacheData* cache_data, Arena* arena) :
+    level_count(cache_data->tlb2_entries > 0 ? 2 : 1),
+    page_bits(std::log2(cache_data->page_size)),
+    page_walk_cycles(cache_data->page_walk_cycles),
+    page_mapping(cache_data->page_mapping),
+    page_table(nullptr),
+    frame_pages(nullptr),
+    mapped_page_count(0)
+{
+    std::size_t entries[2] = { cache_data->tlb_entries, cache_data->tlb2_entries };
+    std::size_t ways[2] = { cache_data->tlb_ways, cache_data->tlb2_ways };
+    // El primer nivel se consulta en paralelo con la cache.
+    std::size_t cycles[2] = { 0, cache_data->tlb2_access_cycles };
+
+    for (std::size_t level = 0; level < this->level_count; ++level)
+    {
+        this->levels[level].entries = arena->allocate<TlbEntry>(entries[level]);
+        this->levels[level].num_of_set_entries = ways[level];
+        this->levels[level].num_of_sets = entries[level] / ways[level];
+        this->levels[level].access_cycles = cycles[level];
+    }
+
+    if (this->page_mapping == SEQUENTIAL_MAPPING)
+    {
+        std::size_t page_count = std::size_t(1) << (ADDRESS_LENGTH - this->page_bits);
+        this->page_table = arena->allocate<std::uint32_t>(page_count);
+        this->frame_pages = arena->allocate<std::uint32_t>(page_count);
+
+        // Despues, reset() solo limpia las paginas que se asignaron.
+        for (std::size_t page = 0; page < page_count; ++page)
+        {
+            this->page_table[page] = 0;
+        }
+    }
+
+    this->reset();
+}
+
+std::size_t AddressTranslator::required_bytes(CacheData* cache_data)
+{
+    std::size_t bytes = Arena::bytes_for<AddressTranslator>(1)
+                        + Arena::bytes_for<TlbEntry>(cache_data->tlb_entries)
+                        + Arena::bytes_for<TlbEntry>(cache_data->tlb2_entries);
+
+    if (cache_data->page_mapping == SEQUENTIAL_MAPPING)
+    {
+        std::size_t page_bits = std::log2(cache_data->page_size);
+        bytes += 2 * Arena::bytes_for<std::uint32_t>(
+            std::size_t(1) << (ADDRESS_LENGTH - page_bits));
+    }
+
+    return bytes;
+}
+
+void AddressTranslator::reset()
+{
+    for (std::size_t level = 0; level < this->level_count; ++level)
+    {
+        TlbLevel* current = &this->levels[level];
+        std::size_t entry_count = current->num_of_sets * current->num_of_set_entries;
+
+        for (std::size_t entry = 0; entry < entry_count; ++entry)
+        {
+            current->entries[entry].page = 0;
+            current->entries[entry].last_use = 0;
+            current->entries[entry].valid = false;
+        }
+
+        current->hit_count = 0;
+    }
+
+    for (std::size_t frame = 0; frame < this->mapped_page_count; ++frame)
+    {
+        this->page_table[this->frame_pages[frame]] = 0;
+    }
+
+    this->mapped_page_count = 0;
+    this->clock = 0;
+    this->page_walk_count = 0;
+    this->translation_cycles = 0;
+}
+
+std::size_t AddressTranslator::translate(std::size_t* address, bool count)
+{
+    std::size_t page = *address >> this->page_bits;
+    std::size_t offset = *address & ((std::size_t(1) << this->page_bits) - 1);
+    std::size_t cycles = 0;
+    std::size_t level = 0;
+
+    while (level < this->level_count && !(this->lookup(&this->levels[level], page)))
+    {
+        cycles += this->levels[level].access_cycles;
+        ++level;
+    }
+
+    if (level < this->level_count)
+    {
+        cycles += this->levels[level].access_cycles;
+        this->levels[level].hit_count += count;
+    }
+    else
+    {
+        // Miss en todos los niveles: recorrer la tabla de paginas.
+        cycles += this->page_walk_cycles;
+        this->page_walk_count += count;
+    }
+
+    // Llenar los niveles superiores al que tenia la pagina.
+    for (std::size_t upper = 0; upper < level && upper < this->level_count; ++upper)
+    {
+        this->insert(&this->levels[upper], page);
+    }
+
+    *address = (this->map_page(page) << this->page_bits) | offset;
+
+    if (count)
+    {
+        this->translation_cycles += cycles;
+    }
+
+    return cycles;
+}
+
+std::size_t AddressTranslator::get_l1_hit_count()
+{
+    return this->levels[0].hit_count;
+}
+
+std::size_t AddressTranslator::get_l2_hit_count()
+{
+    return (this->level_count > 1) ? this->levels[1].hit_count : 0;
+}
+
+std::size_t AddressTranslator::get_page_walk_count()
+{
+    return this->page_walk_count;
+}
+
+std::size_t AddressTranslator::get_translation_cycles()
+{
+    return this->translation_cycles;
+}
+
+bool AddressTranslator::lookup(TlbLevel* level, std::size_t page)
+{
+    TlbEntry* set = &level->entries[(page % level->num_of_sets)
+                                    * level->num_of_set_entries];
+
+    for (std::size_t way = 0; way < level->num_of_set_entries; ++way)
+    {
+        if (set[way].valid && set[way].page == page)
+        {
+            set[way].last_use = ++this->clock;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AddressTranslator::insert(TlbLevel* level, std::size_t page)
+{
+    TlbEntry* set = &level->entries[(page % level->num_of_sets)
+                                    * level->num_of_set_entries];
+    std::size_t victim = 0;
+
+    // Las entradas invalidas tienen last_use 0, asi que se eligen primero.
+    for (std::size_t way = 1; way < level->num_of_set_entries; ++way)
+    {
+        if (set[way].last_use < set[victim].last_use)
+        {
+            victim = way;
+        }
+    }
+
+    set[victim].page = page;
+    set[victim].last_use = ++this->clock;
+    set[victim].valid = true;
+}
+
+std::size_t AddressTranslator::map_page(std::size_t page)
+{
+    std::size_t frame_mask = (std::size_t(1) << (ADDRESS_LENGTH - this->page_bits)) - 1;
+    std::size_t frame = page;
+
+    if (this->page_mapping == SEQUENTIAL_MAPPING)
+    {
+        // Cada pagina nueva recibe el siguiente marco libre.
+        if (this->page_table[page] == 0)
+        {
+            this->frame_pages[this->mapped_page_count] = page;
+            this->page_table[page] = ++this->mapped_page_count;
+        }
+        frame = this->page_table[page] - 1;
+    }
+    else if (this->page_mapping == RANDOM_MAPPING)
+    {
+        frame = page * PAGE_SCATTER_FACTOR;
+    }
+
+    return frame & frame_mask;
+}
@@ -0,0 +1,66 @@
+/**
+ * Codigo fuente de la clase Arena.
+ */
+
+#include "../model/arena.h"
+
+#include <sys/mman.h>
+
+// Tamano de una pagina enorme.
+#define HUGE_PAGE_BYTES (std::size_t(2) << 20)
+
+Arena::Arena(std::size_t capacity) :
+    memory(nullptr),
+    capacity(capacity),
+    used(0),
+    huge_pages(false)
+{
+    void* region = MAP_FAILED;
+
+    if (this->capacity >= HUGE_PAGE_BYTES)
+    {
+        // MAP_HUGETLB exige un multiplo del tamano de la pagina enorme.
+        this->capacity = (this->capacity + HUGE_PAGE_BYTES - 1)
+                         / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+        region = mmap(nullptr, this->capacity, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        this->huge_pages = (region != MAP_FAILED);
+    }
+
+    if (region == MAP_FAILED && this->capacity > 0)
+    {
+        region = mmap(nullptr, this->capacity, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+#ifdef MADV_HUGEPAGE
+        if (region != MAP_FAILED && this->capacity >= HUGE_PAGE_BYTES)
+        {
+            // Si no hay paginas enormes reservadas, pedir transparentes.
+            madvise(region, this->capacity, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+    if (region != MAP_FAILED)
+    {
+        this->memory = static_cast<char*>(region);
+    }
+}
+
+Arena::~Arena()
+{
+    if (this->memory != nullptr)
+    {
+        munmap(this->memory, this->capacity);
+    }
+}
+
+bool Arena::is_valid()
+{
+    return this->memory != nullptr;
+}
+
+bool Arena::uses_huge_pages()
+{
+    return this->huge_pages;
+}
@@ -3,14 +3,56 @@
  */
 
 #include "../model/arguments.h"
+#include "../model/fast_cache.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Claves de los argumentos obligatorios en el archivo de configuracion,
+// en el orden de la linea de comandos.
+static const char* const required_keys[] = {
+    "num_of_sets", "num_of_set_blocks", "num_of_block_bytes", "write_policy_1",
+    "write_policy_2", "replacement", "cache_access_cycles", "memory_access_cycles"
+};
+#define REQUIRED_KEY_COUNT 8
+
+/**
+ * Retorna el grupo de la opcion @a option: las opciones que no se pueden
+ * combinar comparten grupo, y una opcion de la linea de comandos
+ * reemplaza las opciones de su grupo que vengan del archivo de
+ * configuracion.
+ */
+static std::string option_group(const std::string& option)
+{
+    if (option == "--time-sampling")
+    {
+        return "--set-sampling";
+    }
+    if (option == "--socket")
+    {
+        return "--shm";
+    }
+    if (option == "--miss-cache")
+    {
+        return "--victim";
+    }
+    return option;
+}
 
 int analyze_arguments(int argc, char* argv[], CacheData* cache_data)
 {
     int error = 0;
 
-    if (argc >= 9)
+    if (argc >= 3 && std::string(argv[1]) == "--config")
+    {
+        error = read_config_file(argc, argv, cache_data);
+    }
+    else if (argc >= 9)
     {
 
         if (sscanf(argv[1], "%zu", &cache_data->num_of_sets) != 1
@@ -101,6 +143,8 @@ int analyze_arguments(int argc, char* argv[], CacheData* cache_data)
                 cache_data->replacement = 2;
             }
 
+            error = analyze_options(argc, argv, 9, cache_data);
+
             // Especificaciones exclusivas para la etapa 2 del proyecto.
             if (cache_data->num_of_sets > 1 && cache_data->num_of_set_blocks > 1)
             {
@@ -114,6 +158,93 @@ int analyze_arguments(int argc, char* argv[], CacheData* cache_data)
                           << "evaluated in phase #2 of this project.\n";
                 error = -1;
             }
+
+            if (error == 0 && cache_data->sampling == SET_SAMPLING
+                && cache_data->sampling_ratio > cache_data->num_of_sets)
+            {
+                std::cerr << "Error: Set sampling ratio must not exceed "
+                          << "the number of sets\n";
+                error = 13;
+            }
+
+            if (error == 0 && cache_data->tlb2_entries > 0
+                && cache_data->tlb_entries == 0)
+            {
+                std::cerr << "Error: --tlb2 requires --tlb\n";
+                error = 20;
+            }
+
+            // Valores por omision de la traduccion de direcciones.
+            if (cache_data->page_size == 0)
+            {
+                cache_data->page_size = 1 << 12;
+            }
+            if (cache_data->page_walk_cycles == 0)
+            {
+                cache_data->page_walk_cycles = cache_data->memory_access_cycles;
+            }
+
+            // Valores por omision de la memoria principal.
+            if (cache_data->dram_row_bytes == 0)
+            {
+                cache_data->dram_row_bytes = 8192;
+            }
+            if (cache_data->dram_queue_depth == 0)
+            {
+                cache_data->dram_queue_depth = 16;
+            }
+            if (cache_data->dram_t_cas == 0)
+            {
+                cache_data->dram_t_rcd = cache_data->memory_access_cycles / 3;
+                cache_data->dram_t_cas = cache_data->memory_access_cycles / 3;
+                cache_data->dram_t_rp = cache_data->memory_access_cycles / 3;
+                cache_data->dram_t_burst = 4;
+            }
+
+            // Cada sector debe tener al menos la palabra de un store.
+            if (error == 0 && cache_data->sector_count > 0
+                && (cache_data->num_of_block_bytes / cache_data->sector_count < STORE_BYTES
+                    || cache_data->victim_entries > 0))
+            {
+                std::cerr << "Error: Sectors must have at least " << STORE_BYTES
+                          << " bytes, and cannot be used with a victim or "
+                          << "miss cache\n";
+                error = 28;
+            }
+
+            // El muestreo elige los conjuntos con la direccion virtual, y
+            // con TLB la cache se indexa con la fisica.
+            if (error == 0 && cache_data->sampling == SET_SAMPLING
+                && cache_data->tlb_entries > 0)
+            {
+                std::cerr << "Error: --set-sampling cannot be used with --tlb\n";
+                error = 13;
+            }
+
+            if (error == 0 && cache_data->roi
+                && cache_data->input_source != TRACE_INPUT)
+            {
+                std::cerr << "Error: --roi requires a text trace\n";
+                error = 31;
+            }
+
+            if (error == 0 && cache_data->validate
+                && !(FastCache::supports(cache_data)))
+            {
+                std::cerr << "Error: --validate requires lru or fifo, a "
+                          << "direct-mapped or fully-associative cache, and no "
+                          << "sampling, MSHRs, victim cache, TLB, DRAM, --cat, "
+                          << "--icache or --sectors\n";
+                error = 26;
+            }
+
+            if (error == 0 && cache_data->victim_entries > 0
+                && cache_data->num_of_set_blocks != 1)
+            {
+                std::cerr << "Error: Victim and miss caches require "
+                          << "a direct-mapped cache\n";
+                error = 19;
+            }
         }
     }
     else
@@ -123,19 +254,581 @@ int analyze_arguments(int argc, char* argv[], CacheData* cache_data)
                   << "write_policy_1 write_policy_2 "
                   << "replacement_policy "
                   << "cache_access_cycles memory_access_cycles "
-                  << "< trace_file\n\n"
+                  << "< trace_file\n"
+                  << "       cache_simulator --config config_file [options]\n\n"
                   << "write_policy_1 options:\n"
                   << "\twrite-allocate\n" << "\tno-write-allocate\n\n"
                   << "mwrite_policy_2 options:\n"
                   << "\twrite-through\n" << "\twrite-back\n\n"
                   << "replacement_policy options:\n"
-                  << "\tlru\n" << "\tfifo\n" << "\trandom\n";
+                  << "\tlru\n" << "\tfifo\n" << "\trandom\n\n"
+                  << "options:\n"
+                  << "\t--quiet\n"
+                  << "\t--perf\n"
+                  << "\t--analyze window\n"
+                  << "\t--icache sets blocks\n"
+                  << "\t--sectors count\n"
+                  << "\t--parse-threads count\n"
+                  << "\t--cat tenant way_mask\n"
+                  << "\t--warmup references\n"
+                  << "\t--roi\n"
+                  << "\t--compress\n"
+                  << "\t--validate\n"
+                  << "\t--mshr count window\n"
+                  << "\t--victim entries cycles\n"
+                  << "\t--miss-cache entries cycles\n"
+                  << "\t--tlb entries ways\n"
+                  << "\t--tlb2 entries ways cycles\n"
+                  << "\t--page-size 4K|2M|1G\n"
+                  << "\t--page-walk cycles\n"
+                  << "\t--page-mapping identity|sequential|random\n"
+                  << "\t--dram channels ranks banks\n"
+                  << "\t--dram-timing t_rcd t_cas t_rp t_burst\n"
+                  << "\t--dram-row bytes\n"
+                  << "\t--dram-queue depth\n"
+                  << "\t--dram-page open|closed\n"
+                  << "\t--trace path\n"
+                  << "\t--results path\n"
+                  << "\t--results-format json|csv\n"
+                  << "\t--shm name\n"
+                  << "\t--socket path\n"
+                  << "\t--set-sampling ratio\n"
+                  << "\t--time-sampling period window\n";
         error = 1;
     }
 
     return error;
 }
 
+int analyze_options(int argc, char* argv[], int first, CacheData* cache_data)
+{
+    int error = 0;
+
+    for (int index = first; index < argc && error == 0; ++index)
+    {
+        std::string option(argv[index]);
+
+        if (option == "--set-sampling")
+        {
+            if (cache_data->sampling != NO_SAMPLING || index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->sampling_ratio) != 1
+                || cache_data->sampling_ratio <= 1
+                || !(is_power_of_two(cache_data->sampling_ratio)))
+            {
+                std::cerr << "Error: Invalid set sampling ratio\n";
+                std::cerr << "Value must be higher than one and a power of two\n";
+                error = 13;
+            }
+            else
+            {
+                cache_data->sampling = SET_SAMPLING;
+                index += 1;
+            }
+        }
+        else if (option == "--time-sampling")
+        {
+            if (cache_data->sampling != NO_SAMPLING || index + 2 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->sampling_period) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->sampling_window) != 1
+                || cache_data->sampling_window <= 0
+                || cache_data->sampling_window > cache_data->sampling_period)
+            {
+                std::cerr << "Error: Invalid time sampling period or window\n";
+                std::cerr << "Window must be positive and not exceed the period\n";
+                error = 14;
+            }
+            else
+            {
+                cache_data->sampling = TIME_SAMPLING;
+                index += 2;
+            }
+        }
+        else if (option == "--shm" || option == "--socket")
+        {
+            if (cache_data->input_source != TRACE_INPUT || index + 1 >= argc)
+            {
+                std::cerr << "Error: Invalid input source\n";
+                std::cerr << "Only one of --shm or --socket may be given\n";
+                error = 15;
+            }
+            else
+            {
+                cache_data->input_source = (option == "--shm") ? SHM_INPUT
+                                                               : SOCKET_INPUT;
+                cache_data->input_name = argv[index + 1];
+                index += 1;
+            }
+        }
+        else if (option == "--trace" || option == "--results")
+        {
+            if (index + 1 >= argc)
+            {
+                std::cerr << "Error: Missing path for " << option << '\n';
+                error = 29;
+            }
+            else if (option == "--trace")
+            {
+                cache_data->trace_path = argv[index + 1];
+            }
+            else
+            {
+                cache_data->results_path = argv[index + 1];
+            }
+            index += 1;
+        }
+        else if (option == "--results-format")
+        {
+            std::string format = (index + 1 < argc) ? argv[index + 1] : "";
+
+            if (format == "json")
+            {
+                cache_data->results_format = RESULTS_JSON;
+            }
+            else if (format == "csv")
+            {
+                cache_data->results_format = RESULTS_CSV;
+            }
+            else
+            {
+                std::cerr << "Error: Invalid results format\n";
+                std::cerr << "Value must be json or csv\n";
+                error = 30;
+            }
+            index += 1;
+        }
+        else if (option == "--mshr")
+        {
+            if (index + 2 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->mshr_count) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->mshr_window) != 1
+                || cache_data->mshr_count <= 0 || cache_data->mshr_window <= 0)
+            {
+                std::cerr << "Error: Invalid number of MSHRs or window size\n";
+                std::cerr << "Values must be positive\n";
+                error = 18;
+            }
+            else
+            {
+                index += 2;
+            }
+        }
+        else if (option == "--victim" || option == "--miss-cache")
+        {
+            if (cache_data->victim_entries > 0 || index + 2 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->victim_entries) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->victim_access_cycles) != 1
+                || cache_data->victim_entries <= 0
+                || cache_data->victim_access_cycles <= 0)
+            {
+                std::cerr << "Error: Invalid victim cache entries or cycles\n";
+                std::cerr << "Values must be positive\n";
+                error = 19;
+            }
+            else
+            {
+                cache_data->miss_cache = (option == "--miss-cache");
+                index += 2;
+            }
+        }
+        else if (option == "--tlb" || option == "--tlb2")
+        {
+            std::size_t entries = 0;
+            std::size_t ways = 0;
+            std::size_t cycles = 0;
+            int count = (option == "--tlb") ? 2 : 3;
+
+            if (index + count >= argc
+                || sscanf(argv[index + 1], "%zu", &entries) != 1
+                || sscanf(argv[index + 2], "%zu", &ways) != 1
+                || (count == 3 && sscanf(argv[index + 3], "%zu", &cycles) != 1)
+                || !(is_power_of_two(entries)) || !(is_power_of_two(ways))
+                || ways > entries)
+            {
+                std::cerr << "Error: Invalid TLB entries or associativity\n";
+                std::cerr << "Values must be powers of two\n";
+                error = 20;
+            }
+            else if (count == 2)
+            {
+                cache_data->tlb_entries = entries;
+                cache_data->tlb_ways = ways;
+            }
+            else
+            {
+                cache_data->tlb2_entries = entries;
+                cache_data->tlb2_ways = ways;
+                cache_data->tlb2_access_cycles = cycles;
+            }
+            index += count;
+        }
+        else if (option == "--page-size")
+        {
+            std::string size = (index + 1 < argc) ? argv[index + 1] : "";
+            cache_data->page_size = (size == "4K") ? (1 << 12)
+                                  : (size == "2M") ? (1 << 21)
+                                  : (size == "1G") ? (1 << 30) : 0;
+            if (cache_data->page_size == 0)
+            {
+                std::cerr << "Error: Invalid page size\n";
+                std::cerr << "Value must be 4K, 2M or 1G\n";
+                error = 20;
+            }
+            index += 1;
+        }
+        else if (option == "--page-walk")
+        {
+            if (index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->page_walk_cycles) != 1
+                || cache_data->page_walk_cycles <= 0)
+            {
+                std::cerr << "Error: Invalid number of page walk cycles\n";
+                std::cerr << "Value must be positive\n";
+                error = 20;
+            }
+            index += 1;
+        }
+        else if (option == "--page-mapping")
+        {
+            std::string mapping = (index + 1 < argc) ? argv[index + 1] : "";
+            if (mapping == "identity")
+            {
+                cache_data->page_mapping = IDENTITY_MAPPING;
+            }
+            else if (mapping == "sequential")
+            {
+                cache_data->page_mapping = SEQUENTIAL_MAPPING;
+            }
+            else if (mapping == "random")
+            {
+                cache_data->page_mapping = RANDOM_MAPPING;
+            }
+            else
+            {
+                std::cerr << "Error: Invalid page mapping policy\n";
+                error = 20;
+            }
+            index += 1;
+        }
+        else if (option == "--dram")
+        {
+            if (index + 3 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->dram_channels) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->dram_ranks) != 1
+                || sscanf(argv[index + 3], "%zu", &cache_data->dram_banks) != 1
+                || cache_data->dram_channels <= 0 || cache_data->dram_ranks <= 0
+                || cache_data->dram_banks <= 0)
+            {
+                std::cerr << "Error: Invalid number of DRAM channels, ranks or banks\n";
+                std::cerr << "Values must be positive\n";
+                error = 21;
+            }
+            index += 3;
+        }
+        else if (option == "--dram-timing")
+        {
+            if (index + 4 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->dram_t_rcd) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->dram_t_cas) != 1
+                || sscanf(argv[index + 3], "%zu", &cache_data->dram_t_rp) != 1
+                || sscanf(argv[index + 4], "%zu", &cache_data->dram_t_burst) != 1
+                || cache_data->dram_t_cas <= 0)
+            {
+                std::cerr << "Error: Invalid DRAM timing\n";
+                std::cerr << "CAS latency must be positive\n";
+                error = 21;
+            }
+            index += 4;
+        }
+        else if (option == "--dram-row" || option == "--dram-queue")
+        {
+            std::size_t value = 0;
+
+            if (index + 1 >= argc || sscanf(argv[index + 1], "%zu", &value) != 1
+                || value <= 0)
+            {
+                std::cerr << "Error: Invalid DRAM row size or queue depth\n";
+                std::cerr << "Value must be positive\n";
+                error = 21;
+            }
+            else if (option == "--dram-row")
+            {
+                cache_data->dram_row_bytes = value;
+            }
+            else
+            {
+                cache_data->dram_queue_depth = value;
+            }
+            index += 1;
+        }
+        else if (option == "--dram-page")
+        {
+            std::string policy = (index + 1 < argc) ? argv[index + 1] : "";
+            if (policy != "open" && policy != "closed")
+            {
+                std::cerr << "Error: Invalid DRAM page policy\n";
+                error = 21;
+            }
+            cache_data->dram_closed_page = (policy == "closed");
+            index += 1;
+        }
+        else if (option == "--analyze")
+        {
+            if (index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->analyze_window) != 1
+                || cache_data->analyze_window <= 0)
+            {
+                std::cerr << "Error: Invalid trace analysis window\n";
+                std::cerr << "Value must be positive\n";
+                error = 22;
+            }
+            index += 1;
+        }
+        else if (option == "--icache")
+        {
+            if (index + 2 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->icache_sets) != 1
+                || sscanf(argv[index + 2], "%zu", &cache_data->icache_set_blocks) != 1
+                || !(is_power_of_two(cache_data->icache_sets))
+                || !(is_power_of_two(cache_data->icache_set_blocks))
+                || (cache_data->icache_sets > 1 && cache_data->icache_set_blocks > 1))
+            {
+                std::cerr << "Error: Invalid instruction cache sets or blocks\n";
+                std::cerr << "Values must be powers of two, and the cache "
+                          << "direct-mapped or fully-associative\n";
+                error = 23;
+            }
+            index += 2;
+        }
+        else if (option == "--sectors")
+        {
+            if (index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->sector_count) != 1
+                || !(is_power_of_two(cache_data->sector_count))
+                || cache_data->sector_count > 64)
+            {
+                std::cerr << "Error: Invalid number of sectors\n";
+                std::cerr << "Value must be a power of two, at most 64\n";
+                error = 28;
+            }
+            index += 1;
+        }
+        else if (option == "--parse-threads")
+        {
+            if (index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->parse_threads) != 1
+                || cache_data->parse_threads <= 0)
+            {
+                std::cerr << "Error: Invalid number of parse threads\n";
+                std::cerr << "Value must be positive\n";
+                error = 24;
+            }
+            index += 1;
+        }
+        else if (option == "--cat")
+        {
+            std::size_t tenant = 0;
+            std::size_t mask = 0;
+            std::size_t shifted = 0;
+
+            if (index + 2 < argc && sscanf(argv[index + 1], "%zu", &tenant) == 1
+                && sscanf(argv[index + 2], "%zx", &mask) == 1 && mask != 0)
+            {
+                shifted = mask >> __builtin_ctzl(mask);
+            }
+
+            // Como en CAT, la mascara debe ser de bits contiguos.
+            if (shifted == 0 || tenant >= MAX_TENANTS
+                || (shifted & (shifted + 1)) != 0
+                || cache_data->num_of_set_blocks > 64
+                || (cache_data->num_of_set_blocks < 64
+                    && (mask >> cache_data->num_of_set_blocks) != 0))
+            {
+                std::cerr << "Error: Invalid tenant or way mask\n";
+                std::cerr << "Tenant must be lower than " << MAX_TENANTS
+                          << " and the mask a contiguous, non-empty set of "
+                          << "at most 64 ways\n";
+                error = 25;
+            }
+            else
+            {
+                cache_data->way_masks[tenant] = mask;
+                cache_data->partitioned = true;
+            }
+            index += 2;
+        }
+        else if (option == "--warmup")
+        {
+            if (index + 1 >= argc
+                || sscanf(argv[index + 1], "%zu", &cache_data->warmup) != 1)
+            {
+                std::cerr << "Error: Invalid number of warm-up references\n";
+                error = 31;
+            }
+            index += 1;
+        }
+        else if (option == "--roi")
+        {
+            cache_data->roi = true;
+        }
+        else if (option == "--compress")
+        {
+            cache_data->compress = true;
+        }
+        else if (option == "--validate")
+        {
+            cache_data->validate = true;
+        }
+        else if (option == "--quiet")
+        {
+            cache_data->quiet = true;
+        }
+        else if (option == "--perf")
+        {
+            cache_data->perf = true;
+        }
+        else
+        {
+            std::cerr << "Error: Unknown option " << option << '\n';
+            error = 1;
+        }
+    }
+
+    return error;
+}
+
+int read_config_file(int argc, char* argv[], CacheData* cache_data)
+{
+    // Los valores deben vivir mientras se use cache_data, que guarda
+    // punteros a algunos de ellos (como input_name).
+    static std::vector<std::string> arguments;
+    static std::vector<char*> pointers;
+
+    std::ifstream file(argv[2]);
+    std::vector<std::string> required(REQUIRED_KEY_COUNT);
+    std::vector<std::vector<std::string> > options;
+    std::string line;
+    std::size_t line_number = 0;
+
+    if (!(file))
+    {
+        std::cerr << "Error: Could not open config file " << argv[2] << '\n';
+        return 29;
+    }
+
+    while (std::getline(file, line))
+    {
+        ++line_number;
+
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+        {
+            continue;
+        }
+
+        std::size_t equals = line.find('=');
+        std::string key;
+        std::istringstream key_stream(line.substr(0, equals));
+        key_stream >> key;
+
+        if (equals == std::string::npos || key.empty())
+        {
+            std::cerr << "Error: Invalid line #" << line_number
+                      << " in config file\n";
+            return 29;
+        }
+
+        std::istringstream values(line.substr(equals + 1));
+        std::string value;
+        std::size_t required_index = 0;
+
+        while (required_index < REQUIRED_KEY_COUNT
+               && key != required_keys[required_index])
+        {
+            ++required_index;
+        }
+
+        if (required_index < REQUIRED_KEY_COUNT)
+        {
+            values >> required[required_index];
+            continue;
+        }
+
+        for (std::size_t index = 0; index < key.size(); ++index)
+        {
+            key[index] = (key[index] == '_') ? '-' : key[index];
+        }
+
+        std::vector<std::string> option_values;
+        while (values >> value)
+        {
+            option_values.push_back(value);
+        }
+
+        // Una opcion sin valores solo se agrega si es "true".
+        if (option_values.size() == 1 && option_values[0] == "false")
+        {
+            continue;
+        }
+        options.push_back(std::vector<std::string>(1, "--" + key));
+        if (!(option_values.size() == 1 && option_values[0] == "true"))
+        {
+            options.back().insert(options.back().end(), option_values.begin(),
+                                  option_values.end());
+        }
+    }
+
+    arguments.clear();
+    arguments.push_back(argv[0]);
+
+    for (std::size_t index = 0; index < REQUIRED_KEY_COUNT; ++index)
+    {
+        if (required[index].empty())
+        {
+            std::cerr << "Error: Missing " << required_keys[index]
+                      << " in config file\n";
+            return 29;
+        }
+        arguments.push_back(required[index]);
+    }
+
+    // Una opcion de la linea de comandos reemplaza las de su grupo en el
+    // archivo. --cat se puede repetir, asi que se agrega a las del archivo.
+    std::vector<std::string> command_groups;
+    for (int index = 3; index < argc; ++index)
+    {
+        if (std::string(argv[index]).compare(0, 2, "--") == 0)
+        {
+            command_groups.push_back(option_group(argv[index]));
+        }
+    }
+
+    for (std::size_t index = 0; index < options.size(); ++index)
+    {
+        std::string group = option_group(options[index][0]);
+
+        if (group == "--cat" || std::find(command_groups.begin(), command_groups.end(),
+                                          group) == command_groups.end())
+        {
+            arguments.insert(arguments.end(), options[index].begin(),
+                             options[index].end());
+        }
+    }
+
+    for (int index = 3; index < argc; ++index)
+    {
+        arguments.push_back(argv[index]);
+    }
+
+    pointers.clear();
+    for (std::size_t index = 0; index < arguments.size(); ++index)
+    {
+        pointers.push_back(&arguments[index][0]);
+    }
+    pointers.push_back(nullptr);
+
+    return analyze_arguments(arguments.size(), &pointers[0], cache_data);
+}
+
 bool is_power_of_two(std::size_t number)
 {
     return (number != 0 && ((number & (number - 1)) == 0));
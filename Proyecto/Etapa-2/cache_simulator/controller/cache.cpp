@@ -4,6 +4,8 @@
 
 #include "../model/cache.h"
 
+#include <new>
+
 Cache::Cache(CacheData* cache_data) :
     num_of_sets(cache_data->num_of_sets),
     num_of_set_blocks(cache_data->num_of_set_blocks),
@@ -13,12 +15,126 @@ Cache::Cache(CacheData* cache_data) :
     replacement_algorithm(cache_data->replacement),
     cache_access_cycles(cache_data->cache_access_cycles),
     memory_access_cycles(cache_data->memory_access_cycles),
-    blocks(new CacheBlock*[this->num_of_sets])
+    victim_access_cycles(cache_data->victim_access_cycles),
+    miss_cache(cache_data->miss_cache),
+    quiet(cache_data->quiet),
+    sector_count(cache_data->sector_count),
+    sector_bytes((cache_data->sector_count > 0)
+                 ? cache_data->num_of_block_bytes / cache_data->sector_count : 0),
+    partitioned(cache_data->partitioned),
+    fill_counter(0),
+    arena(Cache::required_bytes(cache_data)),
+    timing(nullptr),
+    translator(nullptr),
+    owns_translator(true),
+    victim_cache(nullptr),
+    dram(nullptr),
+    load_latency(nullptr),
+    store_latency(nullptr),
+    blocks(nullptr)
 {
+    this->address_info.tag_length = 0;
+    this->address_info.index_length = 0;
+    this->address_info.offset_length = 0;
+    this->calculate_address_lengths();
+
+    std::size_t all_ways = (this->num_of_set_blocks < 64)
+        ? ((std::size_t) 1 << this->num_of_set_blocks) - 1 : ~(std::size_t) 0;
+
+    for (std::size_t tenant = 0; tenant < MAX_TENANTS; ++tenant)
+    {
+        this->way_masks[tenant] = (cache_data->way_masks[tenant] != 0)
+                                  ? cache_data->way_masks[tenant] : all_ways;
+    }
+
+    if (!(this->arena.is_valid()))
+    {
+        return;
+    }
+
+    // Los componentes opcionales se construyen dentro de la arena, asi que
+    // no se destruyen uno por uno: la arena libera todo junto.
+    if (cache_data->mshr_count > 0)
+    {
+        this->timing = new (this->arena.allocate<MissTiming>(1))
+            MissTiming(cache_data->mshr_count, cache_data->mshr_window, &this->arena);
+    }
+
+    if (cache_data->tlb_entries > 0)
+    {
+        this->translator = new (this->arena.allocate<AddressTranslator>(1))
+            AddressTranslator(cache_data, &this->arena);
+    }
+
+    if (cache_data->dram_channels > 0)
+    {
+        this->dram = new (this->arena.allocate<DramModel>(1))
+            DramModel(cache_data, &this->arena);
+    }
+
+    this->load_latency = new (this->arena.allocate<LatencyHistogram>(1))
+        LatencyHistogram(&this->arena);
+    this->store_latency = new (this->arena.allocate<LatencyHistogram>(1))
+        LatencyHistogram(&this->arena);
+
+    if (cache_data->victim_entries > 0)
+    {
+        this->victim_cache = new (this->arena.allocate<VictimCache>(1))
+            VictimCache(cache_data->victim_entries, &this->arena);
+    }
+
+    this->blocks = this->arena.allocate<CacheBlock*>(this->num_of_sets);
+    CacheBlock* block_array = this->arena.allocate<CacheBlock>(
+        this->num_of_sets * this->num_of_set_blocks);
+
     for (std::size_t set_index = 0; set_index < this->num_of_sets; ++set_index)
     {
-        this->blocks[set_index] = new CacheBlock[this->num_of_set_blocks];
+        this->blocks[set_index] = &block_array[set_index * this->num_of_set_blocks];
+    }
+
+    this->reset();
+}
+
+std::size_t Cache::required_bytes(CacheData* cache_data)
+{
+    std::size_t bytes = Arena::bytes_for<CacheBlock*>(cache_data->num_of_sets)
+                        + Arena::bytes_for<CacheBlock>(cache_data->num_of_sets
+                                                       * cache_data->num_of_set_blocks)
+                        + 2 * LatencyHistogram::required_bytes();
+
+    if (cache_data->mshr_count > 0)
+    {
+        bytes += MissTiming::required_bytes(cache_data->mshr_count,
+                                            cache_data->mshr_window);
+    }
+
+    if (cache_data->tlb_entries > 0)
+    {
+        bytes += AddressTranslator::required_bytes(cache_data);
+    }
+
+    if (cache_data->dram_channels > 0)
+    {
+        bytes += DramModel::required_bytes(cache_data);
+    }
+
+    if (cache_data->victim_entries > 0)
+    {
+        bytes += VictimCache::required_bytes(cache_data->victim_entries);
+    }
 
+    return bytes;
+}
+
+bool Cache::is_valid()
+{
+    return this->blocks != nullptr;
+}
+
+void Cache::reset()
+{
+    for (std::size_t set_index = 0; set_index < this->num_of_sets; ++set_index)
+    {
         for (std::size_t block_index = 0; block_index < this->num_of_set_blocks;
              ++block_index)
         {
@@ -27,13 +143,13 @@ Cache::Cache(CacheData* cache_data) :
             this->blocks[set_index][block_index].dirty = false;
             this->blocks[set_index][block_index].first_in = false;
             this->blocks[set_index][block_index].lru_value = 100;
+            this->blocks[set_index][block_index].fill_order = 0;
+            this->blocks[set_index][block_index].sector_valid = 0;
+            this->blocks[set_index][block_index].sector_dirty = 0;
         }
     }
 
-    this->address_info.tag_length = 0;
-    this->address_info.index_length = 0;
-    this->address_info.offset_length = 0;
-    this->calculate_address_lengths();
+    this->fill_counter = 0;
 
     this->status.load_count = 0;
     this->status.store_count = 0;
@@ -41,110 +157,317 @@ Cache::Cache(CacheData* cache_data) :
     this->status.load_miss_count = 0;
     this->status.store_hit_count = 0;
     this->status.store_miss_count = 0;
+    this->status.ifetch_hit_count = 0;
+    this->status.ifetch_miss_count = 0;
+    this->status.prefetch_hit_count = 0;
+    this->status.prefetch_miss_count = 0;
+    this->status.flush_count = 0;
+    this->status.flush_hit_count = 0;
+    this->status.writeback_count = 0;
     this->status.eviction_count = 0;
     this->status.total_cpu_cycles = 0;
-}
+    this->status.victim_hit_count = 0;
+    this->status.sector_miss_count = 0;
+    this->status.read_bytes = 0;
+    this->status.write_bytes = 0;
 
-Cache::~Cache()
-{
-    for (std::size_t index = 0; index < this->num_of_sets; ++index)
+    for (std::size_t tenant = 0; tenant < MAX_TENANTS; ++tenant)
+    {
+        this->status.tenant_hit_count[tenant] = 0;
+        this->status.tenant_miss_count[tenant] = 0;
+        this->status.tenant_eviction_count[tenant] = 0;
+    }
+
+    if (this->load_latency != nullptr)
+    {
+        this->load_latency->reset();
+        this->store_latency->reset();
+    }
+
+    if (this->timing != nullptr)
+    {
+        this->timing->reset();
+    }
+
+    if (this->translator != nullptr && this->owns_translator)
+    {
+        this->translator->reset();
+    }
+
+    if (this->victim_cache != nullptr)
+    {
+        this->victim_cache->reset();
+    }
+
+    if (this->dram != nullptr)
     {
-        delete this->blocks[index];
+        this->dram->reset();
     }
-    delete [] blocks;
 }
 
-void Cache::handle_reference(Access reference)
+void Cache::share_translator(AddressTranslator* translator)
 {
+    this->translator = translator;
+    this->owns_translator = false;
+}
+
+AccessResult Cache::handle_reference(Access reference)
+{
+    AccessResult result;
+    result.cycles = this->cache_access_cycles;
+
+    if (!(this->quiet))
+    {
+        printf("%c 0x%08lx ", reference.operation, reference.address);
+    }
+
+    if (this->translator != nullptr)
+    {
+        result.cycles += this->translator->translate(&reference.address, true);
+    }
+
     std::size_t address_tag = get_tag(reference.address);
     std::size_t address_index = get_index(reference.address);
-    std::size_t access_cycles = 0;
 
-    access_cycles += this->cache_access_cycles;
+    if (reference.operation == FLUSH)
+    {
+        return this->handle_flush(reference, address_tag, address_index, result);
+    }
+
+    BlockUpdate update = this->update_blocks(address_tag, address_index,
+                                             reference.tenant);
+    result.hit = update.hit;
 
-    if (is_miss(address_tag, address_index))
+    if (this->sector_count > 0)
     {
-        access_cycles += this->memory_access_cycles;
+        SectorUpdate sectors = this->update_sectors(address_tag, address_index,
+                                                    reference.address, update.hit,
+                                                    reference.operation == STORE);
+        if (sectors.sector_miss)
+        {
+            result.hit = false;
+            ++this->status.sector_miss_count;
+        }
 
-        // Direct-Mapped
-        if (num_of_set_blocks == 1)
+        // Cada miss trae de memoria un solo sector.
+        if (!(result.hit))
         {
-            this->blocks[address_index][0].valid = true;
-            this->blocks[address_index][0].tag = address_tag;
+            this->status.read_bytes += this->sector_bytes;
         }
-        // Fully-Associative
-        else if (num_of_sets == 1)
+        this->status.write_bytes += sectors.written_sectors * this->sector_bytes;
+
+        if (reference.operation == STORE && this->write_through)
         {
-            bool updated = false;
-            for (std::size_t block = 0; block < this->num_of_set_blocks && !(updated);
-                 ++block)
-            {
-                if (!(this->blocks[0][block].valid))
-                {
-                    if (block == 0)
-                    {
-                        this->blocks[0][block].first_in = true;
-                    }
+            this->status.write_bytes += STORE_BYTES;
+        }
+    }
 
-                    this->blocks[0][block].valid = true;
-                    this->blocks[0][block].tag = address_tag;
-                    updated = true;
-                }
-            }
-            // Si llega al final hay que hacer reemplazo.
-            if (!(updated))
-            {
-                access_cycles += this->memory_access_cycles;
+    if (result.hit)
+    {
+        ++this->status.tenant_hit_count[reference.tenant];
+    }
+    else
+    {
+        ++this->status.tenant_miss_count[reference.tenant];
+    }
 
-                switch (this->replacement_algorithm)
-                {
-                case LRU:
-                    this->do_lru_replacement(address_tag, 0);
-                    break;
-                case FIFO:
-                    this->do_fifo_replacement(address_tag, 0);
-                    break;
-                case RANDOM:
-                    this->do_random_replacement(address_tag, 0);
-                    break;
-                }
+    if (!(result.hit))
+    {
+        std::size_t fill_cycles = 0;
 
-                ++this->status.eviction_count;
-            }
+        if (update.victim_hit)
+        {
+            // El bloque se obtiene del buffer y no de memoria.
+            fill_cycles = this->victim_access_cycles;
+            ++this->status.victim_hit_count;
+        }
+        else
+        {
+            fill_cycles = this->memory_latency(reference.address, false,
+                                               result.cycles);
         }
 
-        if (reference.operation == LOAD)
+        // El prefetch genera el trafico a memoria pero no espera el bloque.
+        if (reference.operation != PREFETCH)
         {
-            ++this->status.load_miss_count;
+            result.cycles += fill_cycles;
         }
-        else
+
+        if (update.evicted)
         {
-            access_cycles += this->memory_access_cycles;
+            std::size_t evicted_address = (update.evicted_tag
+                << (this->address_info.index_length + this->address_info.offset_length))
+                | (address_index << this->address_info.offset_length);
+            std::size_t write_cycles = this->memory_latency(evicted_address, true,
+                                                            result.cycles);
+            if (reference.operation != PREFETCH)
+            {
+                result.cycles += write_cycles;
+            }
+            ++this->status.eviction_count;
+            ++this->status.tenant_eviction_count[reference.tenant];
+        }
+
+        switch (reference.operation)
+        {
+        case STORE:
+            result.cycles += this->memory_latency(reference.address, true,
+                                                  result.cycles);
             ++this->status.store_miss_count;
+            break;
+        case IFETCH:
+            ++this->status.ifetch_miss_count;
+            break;
+        case PREFETCH:
+            ++this->status.prefetch_miss_count;
+            break;
+        default:
+            ++this->status.load_miss_count;
+            break;
         }
 
-        std::cout << access_cycles << " miss\n";
-        this->status.total_cpu_cycles += access_cycles;
+        if (!(this->quiet))
+        {
+            std::cout << result.cycles << " miss\n";
+        }
     }
     else
     {
-        if (reference.operation == LOAD)
+        switch (reference.operation)
         {
+        case STORE:
+            result.cycles += this->memory_latency(reference.address, true,
+                                                  result.cycles);
+            ++this->status.store_hit_count;
+            break;
+        case IFETCH:
+            ++this->status.ifetch_hit_count;
+            break;
+        case PREFETCH:
+            ++this->status.prefetch_hit_count;
+            break;
+        default:
             ++this->status.load_hit_count;
+            break;
         }
-        else
+
+        if (!(this->quiet))
         {
-            access_cycles += this->memory_access_cycles;
-            ++this->status.store_hit_count;
+            std::cout << result.cycles << " hit\n";
         }
+    }
 
-        std::cout << access_cycles << " hit\n";
-        this->status.total_cpu_cycles += access_cycles;
+    if (reference.operation == LOAD)
+    {
+        this->load_latency->record(result.cycles);
+    }
+    else if (reference.operation == STORE)
+    {
+        this->store_latency->record(result.cycles);
     }
 
-    if (this->replacement_algorithm == LRU)
+    // Para el modelo no bloqueante el prefetch no ocupa un MSHR.
+    this->add_cycles(reference.address,
+                     result.hit || update.victim_hit || reference.operation == PREFETCH,
+                     result.cycles);
+
+    return result;
+}
+
+AccessResult Cache::handle_flush(Access reference, std::size_t tag,
+                                 std::size_t index, AccessResult result)
+{
+    BlockUpdate update = this->flush_block(tag, index);
+    result.hit = update.hit;
+
+    ++this->status.flush_count;
+    if (update.hit)
     {
-        this->update_lru_block(address_tag, address_index);
+        ++this->status.flush_hit_count;
+    }
+
+    if (update.evicted)
+    {
+        result.cycles += this->memory_latency(reference.address, true, result.cycles);
+        ++this->status.writeback_count;
+        this->status.write_bytes += update.dirty_sectors * this->sector_bytes;
+    }
+
+    if (!(this->quiet))
+    {
+        std::cout << result.cycles << (result.hit ? " hit\n" : " miss\n");
+    }
+
+    this->add_cycles(reference.address, true, result.cycles);
+
+    return result;
+}
+
+void Cache::add_cycles(std::size_t address, bool hit, std::size_t cycles)
+{
+    if (this->timing != nullptr)
+    {
+        // Con MSHRs los misses se traslapan: el total es el ciclo en que
+        // termina la ultima referencia, no la suma de las latencias.
+        this->status.total_cpu_cycles = this->timing->add_access(
+            address >> this->address_info.offset_length, hit, cycles);
+    }
+    else
+    {
+        this->status.total_cpu_cycles += cycles;
+    }
+}
+void Cache::warm_reference(Access reference)
+{
+    if (this->translator != nullptr)
+    {
+        this->translator->translate(&reference.address, false);
+    }
+
+    if (reference.operation == FLUSH)
+    {
+        this->flush_block(get_tag(reference.address), get_index(reference.address));
+    }
+    else
+    {
+        std::size_t tag = get_tag(reference.address);
+        std::size_t index = get_index(reference.address);
+        BlockUpdate update = this->update_blocks(tag, index, reference.tenant);
+
+        if (this->sector_count > 0)
+        {
+            this->update_sectors(tag, index, reference.address, update.hit,
+                                 reference.operation == STORE);
+        }
+    }
+}
+
+bool Cache::is_valid_operation(char operation)
+{
+    return operation == LOAD || operation == STORE || operation == IFETCH
+           || operation == PREFETCH || operation == FLUSH;
+}
+
+void Cache::print_set(std::size_t index)
+{
+    for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
+    {
+        CacheBlock* current = &this->blocks[index][block];
+
+        printf("  way %zu: tag 0x%zx%s%s", block, (std::size_t) current->tag,
+               current->valid ? "" : " (invalid)",
+               current->first_in ? " first_in" : "");
+        if (this->replacement_algorithm == LRU)
+        {
+            printf(" lru %zu", current->lru_value);
+        }
+        if (this->sector_count > 0)
+        {
+            printf(" sectors valid 0x%llx dirty 0x%llx",
+                   (unsigned long long) current->sector_valid,
+                   (unsigned long long) current->sector_dirty);
+        }
+        printf("\n");
     }
 }
 
@@ -178,6 +501,41 @@ std::size_t Cache::get_store_miss_count()
     return this->status.store_miss_count;
 }
 
+std::size_t Cache::get_ifetch_hit_count()
+{
+    return this->status.ifetch_hit_count;
+}
+
+std::size_t Cache::get_ifetch_miss_count()
+{
+    return this->status.ifetch_miss_count;
+}
+
+std::size_t Cache::get_prefetch_hit_count()
+{
+    return this->status.prefetch_hit_count;
+}
+
+std::size_t Cache::get_prefetch_miss_count()
+{
+    return this->status.prefetch_miss_count;
+}
+
+std::size_t Cache::get_flush_count()
+{
+    return this->status.flush_count;
+}
+
+std::size_t Cache::get_flush_hit_count()
+{
+    return this->status.flush_hit_count;
+}
+
+std::size_t Cache::get_writeback_count()
+{
+    return this->status.writeback_count;
+}
+
 std::size_t Cache::get_eviction_count()
 {
     return this->status.eviction_count;
@@ -188,6 +546,101 @@ std::size_t Cache::get_total_cpu_cycles()
     return this->status.total_cpu_cycles;
 }
 
+LatencyHistogram* Cache::get_load_latency()
+{
+    return this->load_latency;
+}
+
+LatencyHistogram* Cache::get_store_latency()
+{
+    return this->store_latency;
+}
+
+bool Cache::is_sectored()
+{
+    return this->sector_count > 0;
+}
+
+std::size_t Cache::get_sector_count()
+{
+    return this->sector_count;
+}
+
+std::size_t Cache::get_sector_miss_count()
+{
+    return this->status.sector_miss_count;
+}
+
+std::size_t Cache::get_read_bytes()
+{
+    return this->status.read_bytes;
+}
+
+std::size_t Cache::get_write_bytes()
+{
+    return this->status.write_bytes;
+}
+
+bool Cache::is_partitioned()
+{
+    return this->partitioned;
+}
+
+std::size_t Cache::get_way_mask(std::size_t tenant)
+{
+    return this->way_masks[tenant];
+}
+
+std::size_t Cache::get_tenant_hit_count(std::size_t tenant)
+{
+    return this->status.tenant_hit_count[tenant];
+}
+
+std::size_t Cache::get_tenant_miss_count(std::size_t tenant)
+{
+    return this->status.tenant_miss_count[tenant];
+}
+
+std::size_t Cache::get_tenant_eviction_count(std::size_t tenant)
+{
+    return this->status.tenant_eviction_count[tenant];
+}
+
+AddressTranslator* Cache::get_translator()
+{
+    return this->translator;
+}
+
+DramModel* Cache::get_dram()
+{
+    return this->dram;
+}
+
+bool Cache::has_victim_cache()
+{
+    return this->victim_cache != nullptr;
+}
+
+std::size_t Cache::get_victim_hit_count()
+{
+    return this->status.victim_hit_count;
+}
+
+bool Cache::is_non_blocking()
+{
+    return this->timing != nullptr;
+}
+
+std::size_t Cache::get_mshr_merge_count()
+{
+    return (this->timing != nullptr) ? this->timing->get_merge_count() : 0;
+}
+
+std::size_t Cache::get_mshr_stall_cycles()
+{
+    return (this->timing != nullptr) ? this->timing->get_stall_cycles() : 0;
+}
+
 void Cache::calculate_address_lengths()
 {
     this->address_info.index_length = std::log2(this->num_of_sets);
@@ -213,7 +666,8 @@ bool Cache::is_miss(std::size_t tag, std::size_t index)
 {
     for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
     {
-        if (this->blocks[index][block].tag == tag && this->blocks[index][block].valid)
+        if ((std::size_t) this->blocks[index][block].tag == tag
+            && this->blocks[index][block].valid)
         {
             return false;
         }
@@ -222,10 +676,266 @@ bool Cache::is_miss(std::size_t tag, std::size_t index)
     return true;
 }
 
-void Cache::do_lru_replacement(std::size_t tag, std::size_t index)
+Cache::BlockUpdate Cache::update_blocks(std::size_t tag, std::size_t index,
+                                        std::size_t tenant)
+{
+    BlockUpdate update;
+    update.hit = !(is_miss(tag, index));
+    update.evicted = false;
+    update.victim_hit = false;
+    update.evicted_tag = 0;
+
+    if (!(update.hit))
+    {
+        // Direct-Mapped
+        if (num_of_set_blocks == 1)
+        {
+            if (this->victim_cache != nullptr)
+            {
+                update.victim_hit = this->probe_victim_cache(tag, index);
+            }
+
+            this->blocks[index][0].valid = true;
+            this->blocks[index][0].tag = tag;
+        }
+        // Fully-Associative con particiones
+        else if (num_of_sets == 1 && this->partitioned)
+        {
+            update.evicted = this->fill_partitioned(tag, this->way_masks[tenant],
+                                                    &update.evicted_tag);
+        }
+        // Fully-Associative
+        else if (num_of_sets == 1)
+        {
+            bool updated = false;
+            for (std::size_t block = 0; block < this->num_of_set_blocks && !(updated);
+                 ++block)
+            {
+                if (!(this->blocks[0][block].valid))
+                {
+                    if (block == 0)
+                    {
+                        this->blocks[0][block].first_in = true;
+                    }
+
+                    this->blocks[0][block].valid = true;
+                    this->blocks[0][block].tag = tag;
+                    updated = true;
+                }
+            }
+            // Si llega al final hay que hacer reemplazo.
+            if (!(updated))
+            {
+                switch (this->replacement_algorithm)
+                {
+                case LRU:
+                    update.evicted_tag = this->do_lru_replacement(tag, 0);
+                    break;
+                case FIFO:
+                    update.evicted_tag = this->do_fifo_replacement(tag, 0);
+                    break;
+                case RANDOM:
+                    update.evicted_tag = this->do_random_replacement(tag, 0);
+                    break;
+                }
+
+                update.evicted = true;
+            }
+        }
+    }
+
+    if (this->replacement_algorithm == LRU)
+    {
+        this->update_lru_block(tag, index);
+    }
+
+    return update;
+}
+
+Cache::BlockUpdate Cache::flush_block(std::size_t tag, std::size_t index)
+{
+    BlockUpdate update;
+    update.hit = false;
+    update.evicted = false;
+    update.victim_hit = false;
+    update.evicted_tag = tag;
+    update.dirty_sectors = 0;
+
+    for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
+    {
+        CacheBlock* current = &this->blocks[index][block];
+
+        if ((std::size_t) current->tag == tag && current->valid)
+        {
+            update.hit = true;
+            update.evicted = current->dirty;
+            update.dirty_sectors = __builtin_popcountll(current->sector_dirty);
+            current->valid = false;
+            current->dirty = false;
+            current->sector_valid = 0;
+            current->sector_dirty = 0;
+        }
+    }
+
+    return update;
+}
+
+Cache::SectorUpdate Cache::update_sectors(std::size_t tag, std::size_t index,
+                                          std::size_t address, bool block_hit,
+                                          bool store)
+{
+    SectorUpdate update;
+    update.sector_miss = false;
+    update.written_sectors = 0;
+
+    CacheBlock* block = nullptr;
+    for (std::size_t way = 0; way < this->num_of_set_blocks && block == nullptr; ++way)
+    {
+        CacheBlock* current = &this->blocks[index][way];
+
+        if ((std::size_t) current->tag == tag && current->valid)
+        {
+            block = current;
+        }
+    }
+
+    // El reemplazo FIFO puede no llenar el bloque.
+    if (block == nullptr)
+    {
+        return update;
+    }
+
+    std::size_t sector = (address % this->num_of_block_bytes) / this->sector_bytes;
+    std::uint64_t sector_bit = (std::uint64_t) 1 << sector;
+
+    if (block_hit)
+    {
+        update.sector_miss = !(block->sector_valid & sector_bit);
+        block->sector_valid |= sector_bit;
+    }
+    else
+    {
+        // Los bits que quedan son los del bloque reemplazado.
+        update.written_sectors = __builtin_popcountll(block->sector_dirty);
+        block->sector_valid = sector_bit;
+        block->sector_dirty = 0;
+        block->dirty = false;
+    }
+
+    if (store && !(this->write_through))
+    {
+        block->sector_dirty |= sector_bit;
+        block->dirty = true;
+    }
+
+    return update;
+}
+
+bool Cache::fill_partitioned(std::size_t tag, std::size_t mask,
+                             std::size_t* evicted_tag)
+{
+    CacheBlock* victim = nullptr;
+    std::size_t allowed_count = 0;
+
+    // Primero una via invalida de la mascara; si no hay, el reemplazo
+    // escoge solo entre las vias de la mascara.
+    for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
+    {
+        CacheBlock* current = &this->blocks[0][block];
+
+        if ((mask >> block) & 1)
+        {
+            ++allowed_count;
+
+            if (!(current->valid))
+            {
+                if (victim == nullptr || victim->valid)
+                {
+                    victim = current;
+                }
+            }
+            else if (victim == nullptr || (victim->valid
+                && ((this->replacement_algorithm == LRU
+                     && current->lru_value > victim->lru_value)
+                    || (this->replacement_algorithm == FIFO
+                        && current->fill_order < victim->fill_order))))
+            {
+                victim = current;
+            }
+        }
+    }
+
+    bool evicted = victim->valid;
+
+    if (evicted && this->replacement_algorithm == RANDOM)
+    {
+        std::size_t choice = rand() % allowed_count;
+
+        for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
+        {
+            if (((mask >> block) & 1) && choice-- == 0)
+            {
+                victim = &this->blocks[0][block];
+                break;
+            }
+        }
+    }
+
+    *evicted_tag = victim->tag;
+    victim->tag = tag;
+    victim->valid = true;
+    victim->dirty = false;
+    victim->fill_order = this->fill_counter++;
+
+    return evicted;
+}
+
+std::size_t Cache::memory_latency(std::size_t address, bool write,
+                                  std::size_t elapsed_cycles)
+{
+    if (this->dram == nullptr)
+    {
+        return this->memory_access_cycles;
+    }
+
+    return this->dram->access(address, write,
+                              this->status.total_cpu_cycles + elapsed_cycles);
+}
+
+bool Cache::probe_victim_cache(std::size_t tag, std::size_t index)
+{
+    CacheBlock* block = &this->blocks[index][0];
+    std::size_t line = (tag << this->address_info.index_length) | index;
+    bool victim_hit = false;
+
+    if (this->miss_cache)
+    {
+        // Miss cache: guarda cada bloque traido de memoria.
+        victim_hit = this->victim_cache->lookup(line, false);
+
+        if (!(victim_hit))
+        {
+            this->victim_cache->insert(line);
+        }
+    }
+    else
+    {
+        // Victim cache: intercambia el bloque pedido con el desalojado.
+        victim_hit = this->victim_cache->lookup(line, true);
+
+        if (block->valid)
+        {
+            this->victim_cache->insert(
+                ((std::size_t) block->tag << this->address_info.index_length) | index);
+        }
+    }
+
+    return victim_hit;
+}
+
+std::size_t Cache::do_lru_replacement(std::size_t tag, std::size_t index)
 {
     std::size_t lru_block_index = 0;
-    std::size_t value = 0;
 
     for (std::size_t block = 1; block < this->num_of_set_blocks; ++block)
     {
@@ -236,11 +946,15 @@ void Cache::do_lru_replacement(std::size_t tag, std::size_t index)
         }
     }
 
-    this->blocks[index][lru_block_index].tag = tag;    
+    std::size_t evicted_tag = this->blocks[index][lru_block_index].tag;
+    this->blocks[index][lru_block_index].tag = tag;
+
+    return evicted_tag;
 }
 
-void Cache::do_fifo_replacement(std::size_t tag, std::size_t index)
+std::size_t Cache::do_fifo_replacement(std::size_t tag, std::size_t index)
 {
+    std::size_t evicted_tag = 0;
     bool replaced = false;
     for (std::size_t block = 0; block < this->num_of_set_blocks && !(replaced);
          ++block)
@@ -248,16 +962,23 @@ void Cache::do_fifo_replacement(std::size_t tag, std::size_t index)
         if (this->blocks[index][block].first_in)
         {
             this->blocks[index][block].first_in = false;
+            evicted_tag = this->blocks[index][block].tag;
             this->blocks[index][block].tag = tag;
             this->blocks[index][(block + 1) % this->num_of_set_blocks].first_in = true;
             replaced = true;
         }
     }
+
+    return evicted_tag;
 }
 
-void Cache::do_random_replacement(std::size_t tag, std::size_t index)
+std::size_t Cache::do_random_replacement(std::size_t tag, std::size_t index)
 {
-    this->blocks[index][rand() % this->num_of_set_blocks].tag = tag;
+    CacheBlock* block = &this->blocks[index][rand() % this->num_of_set_blocks];
+    std::size_t evicted_tag = block->tag;
+    block->tag = tag;
+
+    return evicted_tag;
 }
 
 void Cache::update_lru_block(std::size_t tag, std::size_t index)
@@ -267,7 +988,8 @@ void Cache::update_lru_block(std::size_t tag, std::size_t index)
 
     for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
     {
-        if (this->blocks[index][block].tag == tag && this->blocks[index][block].valid)
+        if ((std::size_t) this->blocks[index][block].tag == tag
+            && this->blocks[index][block].valid)
         {
             if (this->blocks[index][block].lru_value == 0)
             {
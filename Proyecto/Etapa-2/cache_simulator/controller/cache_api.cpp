@@ -0,0 +1,171 @@
+/**
+ * Implementacion de la interfaz en C del simulador de cache.
+ */
+
+#include "../model/cache_api.h"
+#include "../model/cache.h"
+
+#include <new>
+
+/**
+ * La cache opaca de la interfaz envuelve un objeto Cache.
+ */
+struct cache_sim
+{
+    Cache cache;
+
+    cache_sim(CacheData* cache_data) : cache(cache_data)
+    {
+    }
+};
+
+/**
+ * Verifica la configuracion recibida con las mismas reglas que
+ * analyze_arguments y la copia en @a cache_data.
+ */
+static int validate_config(const cache_sim_config_t* config, CacheData* cache_data)
+{
+    int error = 0;
+
+    if (config == nullptr)
+    {
+        error = 1;
+    }
+    else if (!(is_power_of_two(config->num_of_sets)))
+    {
+        error = 2;
+    }
+    else if (!(is_power_of_two(config->num_of_set_blocks)))
+    {
+        error = 3;
+    }
+    else if (config->num_of_block_bytes <= 3
+        || !(is_power_of_two(config->num_of_block_bytes)))
+    {
+        error = 4;
+    }
+    else if (!(config->write_allocate) && !(config->write_through))
+    {
+        error = 7;
+    }
+    else if (config->replacement != CACHE_SIM_LRU
+        && config->replacement != CACHE_SIM_FIFO
+        && config->replacement != CACHE_SIM_RANDOM)
+    {
+        error = 8;
+    }
+    else if (config->cache_access_cycles <= 0)
+    {
+        error = 9;
+    }
+    else if (config->memory_access_cycles < config->cache_access_cycles)
+    {
+        error = 10;
+    }
+    // Mismas restricciones de la etapa 2 del proyecto.
+    else if ((config->num_of_sets > 1 && config->num_of_set_blocks > 1)
+        || config->write_allocate || !(config->write_through))
+    {
+        error = -1;
+    }
+    else
+    {
+        cache_data->num_of_sets = config->num_of_sets;
+        cache_data->num_of_set_blocks = config->num_of_set_blocks;
+        cache_data->num_of_block_bytes = config->num_of_block_bytes;
+        cache_data->cache_access_cycles = config->cache_access_cycles;
+        cache_data->memory_access_cycles = config->memory_access_cycles;
+        cache_data->write_allocate = config->write_allocate;
+        cache_data->write_through = config->write_through;
+        cache_data->replacement = config->replacement;
+        cache_data->quiet = true;
+    }
+
+    return error;
+}
+
+int cache_sim_api_version(void)
+{
+    return CACHE_SIM_API_VERSION;
+}
+
+cache_sim_t* cache_sim_create(const cache_sim_config_t* config, int* error)
+{
+    CacheData cache_data = CacheData();
+    cache_sim_t* cache = nullptr;
+
+    int result = validate_config(config, &cache_data);
+
+    if (result == 0)
+    {
+        cache = new (std::nothrow) cache_sim(&cache_data);
+
+        if (cache != nullptr && !(cache->cache.is_valid()))
+        {
+            delete cache;
+            cache = nullptr;
+        }
+
+        if (cache == nullptr)
+        {
+            result = 12;
+        }
+    }
+
+    if (error != nullptr)
+    {
+        *error = result;
+    }
+
+    return cache;
+}
+
+void cache_sim_destroy(cache_sim_t* cache)
+{
+    delete cache;
+}
+
+size_t cache_sim_access_batch(cache_sim_t* cache,
+                              const cache_sim_access_t* accesses, size_t count)
+{
+    Access access;
+    size_t index = 0;
+
+    for (; index < count; ++index)
+    {
+        if (!(Cache::is_valid_operation(accesses[index].operation))
+            || accesses[index].address > 0xffffffff)
+        {
+            break;
+        }
+
+        access.operation = accesses[index].operation;
+        access.tenant = 0;
+        access.has_value = false;
+        access.value = 0;
+        access.address = accesses[index].address;
+        cache->cache.handle_reference(access);
+    }
+
+    return index;
+}
+
+void cache_sim_get_stats(cache_sim_t* cache, cache_sim_stats_t* stats)
+{
+    stats->load_hit_count = cache->cache.get_load_hit_count();
+    stats->load_miss_count = cache->cache.get_load_miss_count();
+    stats->store_hit_count = cache->cache.get_store_hit_count();
+    stats->store_miss_count = cache->cache.get_store_miss_count();
+    stats->eviction_count = cache->cache.get_eviction_count();
+    stats->total_cpu_cycles = cache->cache.get_total_cpu_cycles();
+    stats->ifetch_hit_count = cache->cache.get_ifetch_hit_count();
+    stats->ifetch_miss_count = cache->cache.get_ifetch_miss_count();
+    stats->prefetch_hit_count = cache->cache.get_prefetch_hit_count();
+    stats->prefetch_miss_count = cache->cache.get_prefetch_miss_count();
+    stats->flush_count = cache->cache.get_flush_count();
+}
+
+void cache_sim_reset(cache_sim_t* cache)
+{
+    cache->cache.reset();
+}
@@ -0,0 +1,297 @@
+/**
+ * Codigo fuente de la clase CompressedCache.
+ */
+
+#include "../model/compressed_cache.h"
+
+#include <cmath>
+
+// Posicion de una linea que no existe.
+#define NO_POSITION ((std::size_t) -1)
+
+CompressedCache::CompressedCache(CacheData* cache_data, bool compress) :
+    num_of_sets(cache_data->num_of_sets),
+    num_of_block_bytes(cache_data->num_of_block_bytes),
+    offset_length(std::log2(cache_data->num_of_block_bytes)),
+    compress(compress),
+    set_budget(cache_data->num_of_set_blocks * cache_data->num_of_block_bytes),
+    set_lines(compress ? 2 * cache_data->num_of_set_blocks
+                       : cache_data->num_of_set_blocks),
+    tags(cache_data->num_of_sets * set_lines, 0),
+    sizes(cache_data->num_of_sets * set_lines, 0),
+    last_use(cache_data->num_of_sets * set_lines, 0),
+    valid(cache_data->num_of_sets * set_lines, false),
+    used_bytes(cache_data->num_of_sets, 0),
+    clock(0),
+    line_words(cache_data->num_of_block_bytes / WORD_BYTES, 0),
+    hit_count(0),
+    miss_count(0),
+    eviction_count(0),
+    resident_lines(0),
+    resident_sum(0),
+    reference_count(0),
+    fill_count(0),
+    fill_bytes(0),
+    zero_line_count(0)
+{
+}
+
+void CompressedCache::handle_reference(Access reference)
+{
+    std::size_t line = reference.address >> this->offset_length;
+    std::size_t set = line & (this->num_of_sets - 1);
+    std::size_t first = set * this->set_lines;
+    std::size_t position = first;
+
+    while (position < first + this->set_lines
+           && !(this->valid[position] && this->tags[position] == line))
+    {
+        ++position;
+    }
+    bool hit = (position < first + this->set_lines);
+
+    if (reference.operation == FLUSH)
+    {
+        if (hit)
+        {
+            this->remove_line(set, position);
+        }
+        return;
+    }
+
+    bool changed = false;
+    if (this->compress && reference.has_value)
+    {
+        std::uint32_t& word = this->memory[reference.address / WORD_BYTES];
+        changed = (word != reference.value);
+        word = reference.value;
+    }
+
+    if (hit)
+    {
+        ++this->hit_count;
+
+        // Un valor nuevo puede hacer que la linea ya no quepa.
+        if (changed)
+        {
+            std::size_t size = this->line_size(line);
+            this->used_bytes[set] -= this->sizes[position];
+            this->sizes[position] = 0;
+            this->make_room(set, size, false, position);
+            this->sizes[position] = size;
+            this->used_bytes[set] += size;
+        }
+    }
+    else
+    {
+        ++this->miss_count;
+
+        std::size_t size = this->compress ? this->line_size(line)
+                                          : this->num_of_block_bytes;
+        this->make_room(set, size, true, NO_POSITION);
+
+        position = first;
+        while (this->valid[position])
+        {
+            ++position;
+        }
+
+        this->tags[position] = line;
+        this->sizes[position] = size;
+        this->valid[position] = true;
+        this->used_bytes[set] += size;
+        ++this->resident_lines;
+
+        ++this->fill_count;
+        this->fill_bytes += size;
+        if (this->compress && size == ZERO_LINE_BYTES)
+        {
+            ++this->zero_line_count;
+        }
+    }
+
+    this->last_use[position] = ++this->clock;
+    this->resident_sum += this->resident_lines;
+    ++this->reference_count;
+}
+
+void CompressedCache::warm_reference(Access reference)
+{
+    std::size_t counters[] = {
+        this->hit_count, this->miss_count, this->eviction_count, this->resident_sum,
+        this->reference_count, this->fill_count, this->fill_bytes,
+        this->zero_line_count
+    };
+
+    this->handle_reference(reference);
+
+    this->hit_count = counters[0];
+    this->miss_count = counters[1];
+    this->eviction_count = counters[2];
+    this->resident_sum = counters[3];
+    this->reference_count = counters[4];
+    this->fill_count = counters[5];
+    this->fill_bytes = counters[6];
+    this->zero_line_count = counters[7];
+}
+
+std::size_t CompressedCache::compressed_size(const std::uint32_t* words,
+                                             std::size_t word_count)
+{
+    std::size_t uncompressed = word_count * WORD_BYTES;
+    bool zeros = true;
+    bool repeated = true;
+
+    for (std::size_t index = 0; index < word_count; ++index)
+    {
+        zeros = zeros && words[index] == 0;
+        repeated = repeated && words[index] == words[0];
+    }
+
+    if (zeros)
+    {
+        return ZERO_LINE_BYTES;
+    }
+    if (repeated && word_count > 1)
+    {
+        return REPEATED_LINE_BYTES;
+    }
+
+    std::size_t best = uncompressed;
+
+    // BDI: cada palabra es un delta con signo de la base explicita (la
+    // primera palabra que no cabe como inmediato) o de la base implicita
+    // 0. Ademas de la base y los deltas se guarda un bit por palabra.
+    for (std::size_t delta_bytes = 1; delta_bytes <= 2; ++delta_bytes)
+    {
+        std::int64_t limit = (std::int64_t) 1 << (8 * delta_bytes - 1);
+        std::uint32_t base = 0;
+        bool has_base = false;
+        bool fits = true;
+
+        for (std::size_t index = 0; index < word_count && fits; ++index)
+        {
+            std::int64_t immediate = (std::int32_t) words[index];
+
+            if (immediate < -limit || immediate >= limit)
+            {
+                if (!(has_base))
+                {
+                    base = words[index];
+                    has_base = true;
+                }
+
+                std::int64_t delta = (std::int32_t) (words[index] - base);
+                fits = (delta >= -limit && delta < limit);
+            }
+        }
+
+        std::size_t size = WORD_BYTES + word_count * delta_bytes + (word_count + 7) / 8;
+        if (fits && size < best)
+        {
+            best = size;
+        }
+    }
+
+    return best;
+}
+
+bool CompressedCache::is_compressed()
+{
+    return this->compress;
+}
+
+std::size_t CompressedCache::get_hit_count()
+{
+    return this->hit_count;
+}
+
+std::size_t CompressedCache::get_miss_count()
+{
+    return this->miss_count;
+}
+
+std::size_t CompressedCache::get_eviction_count()
+{
+    return this->eviction_count;
+}
+
+std::size_t CompressedCache::get_capacity_lines()
+{
+    return this->num_of_sets * (this->set_budget / this->num_of_block_bytes);
+}
+
+double CompressedCache::get_average_resident_lines()
+{
+    return (this->reference_count > 0)
+           ? (double) this->resident_sum / this->reference_count : 0;
+}
+
+double CompressedCache::get_average_line_bytes()
+{
+    return (this->fill_count > 0) ? (double) this->fill_bytes / this->fill_count : 0;
+}
+
+std::size_t CompressedCache::get_zero_line_count()
+{
+    return this->zero_line_count;
+}
+
+std::size_t CompressedCache::line_size(std::size_t line)
+{
+    std::size_t word_count = this->line_words.size();
+    std::size_t first_word = (line << this->offset_length) / WORD_BYTES;
+
+    for (std::size_t index = 0; index < word_count; ++index)
+    {
+        std::unordered_map<std::size_t, std::uint32_t>::iterator found =
+            this->memory.find(first_word + index);
+
+        this->line_words[index] = (found != this->memory.end()) ? found->second : 0;
+    }
+
+    return compressed_size(&this->line_words[0], word_count);
+}
+
+void CompressedCache::make_room(std::size_t set, std::size_t bytes, bool need_line,
+                                std::size_t keep)
+{
+    std::size_t first = set * this->set_lines;
+
+    while (true)
+    {
+        std::size_t free_lines = 0;
+        std::size_t victim = NO_POSITION;
+
+        for (std::size_t position = first; position < first + this->set_lines;
+             ++position)
+        {
+            if (!(this->valid[position]))
+            {
+                ++free_lines;
+            }
+            else if (position != keep && (victim == NO_POSITION
+                     || this->last_use[position] < this->last_use[victim]))
+            {
+                victim = position;
+            }
+        }
+
+        if ((free_lines > 0 || !(need_line))
+            && this->used_bytes[set] + bytes <= this->set_budget)
+        {
+            return;
+        }
+
+        this->remove_line(set, victim);
+        ++this->eviction_count;
+    }
+}
+
+void CompressedCache::remove_line(std::size_t set, std::size_t position)
+{
+    this->used_bytes[set] -= this->sizes[position];
+    this->sizes[position] = 0;
+    this->valid[position] = false;
+    --this->resident_lines;
+}
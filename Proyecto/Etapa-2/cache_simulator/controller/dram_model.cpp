@@ -0,0 +1,250 @@
+/**
+ * Codigo fuente de la clase DramModel.
+ */
+
+#include "../model/dram_model.h"
+
+DramModel::DramModel(CacheData* cache_data, Arena* arena) :
+    num_of_channels(cache_data->dram_channels),
+    num_of_ranks(cache_data->dram_ranks),
+    num_of_banks(cache_data->dram_banks),
+    num_of_block_bytes(cache_data->num_of_block_bytes),
+    blocks_per_row(cache_data->dram_row_bytes / cache_data->num_of_block_bytes),
+    queue_depth(cache_data->dram_queue_depth),
+    t_rcd(cache_data->dram_t_rcd),
+    t_cas(cache_data->dram_t_cas),
+    t_rp(cache_data->dram_t_rp),
+    t_burst(cache_data->dram_t_burst),
+    closed_page(cache_data->dram_closed_page),
+    channels(arena->allocate<DramChannel>(this->num_of_channels)),
+    banks(arena->allocate<DramBank>(this->num_of_channels * this->num_of_ranks
+                                    * this->num_of_banks))
+{
+    if (this->blocks_per_row == 0)
+    {
+        this->blocks_per_row = 1;
+    }
+
+    for (std::size_t channel = 0; channel < this->num_of_channels; ++channel)
+    {
+        this->channels[channel].queue = arena->allocate<DramRequest>(this->queue_depth);
+    }
+
+    this->reset();
+}
+
+std::size_t DramModel::required_bytes(CacheData* cache_data)
+{
+    return Arena::bytes_for<DramModel>(1)
+           + Arena::bytes_for<DramChannel>(cache_data->dram_channels)
+           + cache_data->dram_channels
+             * Arena::bytes_for<DramRequest>(cache_data->dram_queue_depth)
+           + Arena::bytes_for<DramBank>(cache_data->dram_channels
+                                        * cache_data->dram_ranks
+                                        * cache_data->dram_banks);
+}
+
+void DramModel::reset()
+{
+    for (std::size_t channel = 0; channel < this->num_of_channels; ++channel)
+    {
+        this->channels[channel].queue_count = 0;
+        this->channels[channel].bus_ready_cycle = 0;
+    }
+
+    std::size_t bank_count = this->num_of_channels * this->num_of_ranks
+                             * this->num_of_banks;
+
+    for (std::size_t bank = 0; bank < bank_count; ++bank)
+    {
+        this->banks[bank].row_open = false;
+        this->banks[bank].open_row = 0;
+        this->banks[bank].ready_cycle = 0;
+    }
+
+    this->request_count = 0;
+    this->row_hit_count = 0;
+    this->row_conflict_count = 0;
+    this->first_arrival_cycle = 0;
+    this->last_completion_cycle = 0;
+}
+
+std::size_t DramModel::access(std::size_t address, bool write, std::size_t cycle)
+{
+    // Bloques consecutivos se reparten entre canales, y cada fila guarda
+    // blocks_per_row bloques consecutivos del mismo canal.
+    std::size_t block = address / this->num_of_block_bytes;
+    std::size_t channel = block % this->num_of_channels;
+    block /= this->num_of_channels;
+    block /= this->blocks_per_row;
+    std::size_t bank = block % (this->num_of_ranks * this->num_of_banks);
+    std::size_t row = block / (this->num_of_ranks * this->num_of_banks);
+
+    DramChannel* current = &this->channels[channel];
+    std::size_t served_id = 0;
+    std::size_t wait = 0;
+
+    if (this->request_count == 0)
+    {
+        this->first_arrival_cycle = cycle;
+    }
+
+    // Atender primero las solicitudes que habrian empezado antes de esta.
+    while (current->queue_count > 0 && this->next_start_cycle(channel) < cycle)
+    {
+        this->serve_next(channel, &served_id);
+    }
+
+    // Si la cola esta llena hay que esperar a que se libere un espacio.
+    if (current->queue_count == this->queue_depth)
+    {
+        std::size_t completion_cycle = this->serve_next(channel, &served_id);
+
+        if (completion_cycle > cycle)
+        {
+            wait = completion_cycle - cycle;
+        }
+    }
+
+    DramRequest* request = &current->queue[current->queue_count++];
+    request->id = this->request_count++;
+    request->bank = bank;
+    request->row = row;
+    request->arrival_cycle = cycle + wait;
+    request->write = write;
+
+    if (write)
+    {
+        return wait;
+    }
+
+    // Una lectura espera hasta que la cola la atienda.
+    std::size_t id = request->id;
+    std::size_t completion_cycle = cycle;
+
+    do
+    {
+        completion_cycle = this->serve_next(channel, &served_id);
+    }
+    while (served_id != id);
+
+    return completion_cycle - cycle;
+}
+
+std::size_t DramModel::get_request_count()
+{
+    return this->request_count;
+}
+
+std::size_t DramModel::get_row_hit_count()
+{
+    return this->row_hit_count;
+}
+
+std::size_t DramModel::get_row_conflict_count()
+{
+    return this->row_conflict_count;
+}
+
+double DramModel::get_bandwidth()
+{
+    std::size_t cycles = this->last_completion_cycle - this->first_arrival_cycle;
+
+    return (cycles > 0)
+        ? (double) (this->request_count * this->num_of_block_bytes) / cycles
+        : 0;
+}
+
+std::size_t DramModel::pick_next(std::size_t channel)
+{
+    DramChannel* current = &this->channels[channel];
+
+    // La cola esta en orden de llegada.
+    for (std::size_t position = 0; position < current->queue_count; ++position)
+    {
+        DramBank* bank = this->get_bank(channel, &current->queue[position]);
+
+        if (bank->row_open && bank->open_row == current->queue[position].row)
+        {
+            return position;
+        }
+    }
+
+    return 0;
+}
+
+std::size_t DramModel::next_start_cycle(std::size_t channel)
+{
+    DramRequest* request = &this->channels[channel].queue[this->pick_next(channel)];
+    DramBank* bank = this->get_bank(channel, request);
+
+    return (bank->ready_cycle > request->arrival_cycle)
+        ? bank->ready_cycle : request->arrival_cycle;
+}
+
+std::size_t DramModel::serve_next(std::size_t channel, std::size_t* served_id)
+{
+    DramChannel* current = &this->channels[channel];
+    std::size_t position = this->pick_next(channel);
+    DramRequest* request = &current->queue[position];
+    DramBank* bank = this->get_bank(channel, request);
+
+    std::size_t start_cycle = this->next_start_cycle(channel);
+    std::size_t latency = this->t_rcd + this->t_cas;
+
+    if (bank->row_open && bank->open_row == request->row)
+    {
+        latency = this->t_cas;
+        ++this->row_hit_count;
+    }
+    else if (bank->row_open)
+    {
+        latency += this->t_rp;
+        ++this->row_conflict_count;
+    }
+
+    // Los datos esperan a que el bus del canal este libre.
+    std::size_t data_cycle = start_cycle + latency;
+    if (current->bus_ready_cycle > data_cycle)
+    {
+        data_cycle = current->bus_ready_cycle;
+    }
+
+    std::size_t completion_cycle = data_cycle + this->t_burst;
+    current->bus_ready_cycle = completion_cycle;
+
+    if (this->closed_page)
+    {
+        bank->row_open = false;
+        bank->ready_cycle = completion_cycle + this->t_rp;
+    }
+    else
+    {
+        bank->row_open = true;
+        bank->open_row = request->row;
+        bank->ready_cycle = start_cycle + latency;
+    }
+
+    if (completion_cycle > this->last_completion_cycle)
+    {
+        this->last_completion_cycle = completion_cycle;
+    }
+
+    *served_id = request->id;
+
+    // Sacar la solicitud de la cola conservando el orden de llegada.
+    for (std::size_t next = position + 1; next < current->queue_count; ++next)
+    {
+        current->queue[next - 1] = current->queue[next];
+    }
+    --current->queue_count;
+
+    return completion_cycle;
+}
+
+DramModel::DramBank* DramModel::get_bank(std::size_t channel,
+                                         const DramRequest* request)
+{
+    return &this->banks[channel * this->num_of_ranks * this->num_of_banks
+                        + request->bank];
+}
@@ -0,0 +1,319 @@
+/**
+ * Codigo fuente de la clase FastCache.
+ */
+
+#include "../model/fast_cache.h"
+
+#include <cmath>
+#include <cstdio>
+
+// Via que marca el final de la lista LRU.
+#define NO_WAY ((std::size_t) -1)
+
+FastCache::FastCache(CacheData* cache_data) :
+    num_of_sets(cache_data->num_of_sets),
+    num_of_set_blocks(cache_data->num_of_set_blocks),
+    offset_length(std::log2(cache_data->num_of_block_bytes)),
+    index_length(std::log2(cache_data->num_of_sets)),
+    replacement_algorithm(cache_data->replacement),
+    cache_access_cycles(cache_data->cache_access_cycles),
+    memory_access_cycles(cache_data->memory_access_cycles),
+    tags(cache_data->num_of_sets * cache_data->num_of_set_blocks, 0),
+    valid(cache_data->num_of_sets * cache_data->num_of_set_blocks, false),
+    valid_count(0),
+    newer(cache_data->num_of_set_blocks, NO_WAY),
+    older(cache_data->num_of_set_blocks, NO_WAY),
+    most_recent(NO_WAY),
+    least_recent(NO_WAY),
+    first_in(cache_data->num_of_set_blocks, false),
+    first_in_count(0),
+    first_in_way(0),
+    eviction_count(0),
+    total_cpu_cycles(0)
+{
+    if (this->num_of_set_blocks > 1)
+    {
+        this->way_of_tag.reserve(2 * this->num_of_set_blocks);
+    }
+}
+
+bool FastCache::supports(CacheData* cache_data)
+{
+    return cache_data->replacement != RANDOM
+           && !(cache_data->num_of_sets > 1 && cache_data->num_of_set_blocks > 1)
+           && cache_data->mshr_count == 0 && cache_data->victim_entries == 0
+           && cache_data->tlb_entries == 0 && cache_data->dram_channels == 0
+           && !(cache_data->partitioned) && cache_data->icache_sets == 0
+           && cache_data->sector_count <= 1
+           && cache_data->sampling == NO_SAMPLING;
+}
+
+AccessResult FastCache::handle_reference(Access reference)
+{
+    AccessResult result;
+    result.cycles = this->cache_access_cycles;
+
+    std::size_t tag = reference.address >> (this->index_length + this->offset_length);
+    std::size_t index = (reference.address >> this->offset_length)
+                        & (this->num_of_sets - 1);
+    bool evicted = false;
+
+    if (reference.operation == FLUSH)
+    {
+        // Con write-through los bloques nunca estan sucios.
+        if (this->num_of_set_blocks == 1)
+        {
+            result.hit = this->valid[index] && this->tags[index] == tag;
+            this->valid[index] = this->valid[index] && !(result.hit);
+        }
+        else
+        {
+            result.hit = this->flush_associative(tag);
+        }
+    }
+    else
+    {
+        if (this->num_of_set_blocks == 1)
+        {
+            // Direct-mapped: Cache no cuenta el bloque reemplazado
+            // como desalojo.
+            result.hit = this->valid[index] && this->tags[index] == tag;
+            this->tags[index] = tag;
+            this->valid[index] = true;
+        }
+        else
+        {
+            result.hit = this->access_associative(tag, &evicted);
+        }
+
+        // El prefetch solo cuesta el acceso a la cache.
+        if (reference.operation != PREFETCH)
+        {
+            if (!(result.hit))
+            {
+                result.cycles += this->memory_access_cycles;
+            }
+            if (evicted)
+            {
+                result.cycles += this->memory_access_cycles;
+            }
+            if (reference.operation == STORE)
+            {
+                result.cycles += this->memory_access_cycles;
+            }
+        }
+
+        if (evicted)
+        {
+            ++this->eviction_count;
+        }
+    }
+
+    this->total_cpu_cycles += result.cycles;
+
+    return result;
+}
+
+void FastCache::warm_reference(Access reference)
+{
+    std::size_t eviction_count = this->eviction_count;
+    std::size_t total_cpu_cycles = this->total_cpu_cycles;
+
+    this->handle_reference(reference);
+
+    this->eviction_count = eviction_count;
+    this->total_cpu_cycles = total_cpu_cycles;
+}
+
+bool FastCache::access_associative(std::size_t tag, bool* evicted)
+{
+    std::unordered_map<std::size_t, std::size_t>::iterator found =
+        this->way_of_tag.find(tag);
+    std::size_t way = 0;
+    bool hit = (found != this->way_of_tag.end());
+
+    if (hit)
+    {
+        way = found->second;
+    }
+    else if (this->valid_count < this->num_of_set_blocks)
+    {
+        // Como Cache, se llena la primera via invalida.
+        while (this->valid[way])
+        {
+            ++way;
+        }
+
+        if (way == 0)
+        {
+            this->set_first_in(0);
+        }
+
+        this->valid[way] = true;
+        ++this->valid_count;
+        this->tags[way] = tag;
+        this->way_of_tag[tag] = way;
+    }
+    else
+    {
+        *evicted = true;
+
+        if (this->replacement_algorithm == LRU)
+        {
+            way = this->least_recent;
+        }
+        else if (this->first_in_count > 0)
+        {
+            way = this->first_in_way;
+            this->first_in[way] = false;
+            --this->first_in_count;
+
+            for (std::size_t next = way; this->first_in_count > 0
+                 && next < this->num_of_set_blocks; ++next)
+            {
+                if (this->first_in[next])
+                {
+                    this->first_in_way = next;
+                    break;
+                }
+            }
+            this->set_first_in((way + 1) % this->num_of_set_blocks);
+        }
+        else
+        {
+            // Sin bandera first_in, Cache cuenta el desalojo pero no
+            // reemplaza ningun bloque.
+            return false;
+        }
+
+        this->way_of_tag.erase(this->tags[way]);
+        this->tags[way] = tag;
+        this->way_of_tag[tag] = way;
+    }
+
+    // Una via recien llenada no esta en la lista; las demas se mueven
+    // al frente si no estan ahi.
+    if (this->replacement_algorithm == LRU
+        && (!(hit || *evicted) || this->most_recent != way))
+    {
+        if (hit || *evicted)
+        {
+            this->unlink_way(way);
+        }
+        this->push_most_recent(way);
+    }
+
+    return hit;
+}
+
+bool FastCache::flush_associative(std::size_t tag)
+{
+    std::unordered_map<std::size_t, std::size_t>::iterator found =
+        this->way_of_tag.find(tag);
+
+    if (found == this->way_of_tag.end())
+    {
+        return false;
+    }
+
+    std::size_t way = found->second;
+    this->way_of_tag.erase(found);
+    this->valid[way] = false;
+    --this->valid_count;
+
+    if (this->replacement_algorithm == LRU)
+    {
+        this->unlink_way(way);
+    }
+
+    return true;
+}
+
+void FastCache::unlink_way(std::size_t way)
+{
+    if (this->newer[way] != NO_WAY)
+    {
+        this->older[this->newer[way]] = this->older[way];
+    }
+    else
+    {
+        this->most_recent = this->older[way];
+    }
+
+    if (this->older[way] != NO_WAY)
+    {
+        this->newer[this->older[way]] = this->newer[way];
+    }
+    else
+    {
+        this->least_recent = this->newer[way];
+    }
+
+    this->newer[way] = NO_WAY;
+    this->older[way] = NO_WAY;
+}
+
+void FastCache::push_most_recent(std::size_t way)
+{
+    this->newer[way] = NO_WAY;
+    this->older[way] = this->most_recent;
+
+    if (this->most_recent != NO_WAY)
+    {
+        this->newer[this->most_recent] = way;
+    }
+    else
+    {
+        this->least_recent = way;
+    }
+
+    this->most_recent = way;
+}
+
+void FastCache::set_first_in(std::size_t way)
+{
+    if (!(this->first_in[way]))
+    {
+        this->first_in[way] = true;
+        ++this->first_in_count;
+
+        if (this->first_in_count == 1 || way < this->first_in_way)
+        {
+            this->first_in_way = way;
+        }
+    }
+}
+
+void FastCache::print_set(std::size_t index)
+{
+    for (std::size_t block = 0; block < this->num_of_set_blocks; ++block)
+    {
+        std::size_t position = index * this->num_of_set_blocks + block;
+
+        printf("  way %zu: tag 0x%zx%s%s\n", block, this->tags[position],
+               this->valid[position] ? "" : " (invalid)",
+               (this->num_of_set_blocks > 1 && this->first_in[block])
+               ? " first_in" : "");
+    }
+
+    if (this->replacement_algorithm == LRU && this->num_of_set_blocks > 1)
+    {
+        printf("  LRU order (most to least recent):");
+        for (std::size_t way = this->most_recent; way != NO_WAY;
+             way = this->older[way])
+        {
+            printf(" %zu", way);
+        }
+        printf("\n");
+    }
+}
+
+std::size_t FastCache::get_eviction_count()
+{
+    return this->eviction_count;
+}
+
+std::size_t FastCache::get_total_cpu_cycles()
+{
+    return this->total_cpu_cycles;
+}
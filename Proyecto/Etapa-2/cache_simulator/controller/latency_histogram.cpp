@@ -0,0 +1,83 @@
+/**
+ * Codigo fuente de la clase LatencyHistogram.
+ */
+
+#include "../model/latency_histogram.h"
+
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram(Arena* arena) :
+    counts(arena->allocate<std::size_t>(LATENCY_BUCKETS))
+{
+    this->reset();
+}
+
+std::size_t LatencyHistogram::required_bytes()
+{
+    return Arena::bytes_for<LatencyHistogram>(1)
+           + Arena::bytes_for<std::size_t>(LATENCY_BUCKETS);
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+    {
+        this->counts[bucket] = 0;
+    }
+
+    this->total_count = 0;
+    this->max_value = 0;
+}
+
+std::size_t LatencyHistogram::get_percentile(double percentile)
+{
+    if (this->total_count == 0)
+    {
+        return 0;
+    }
+
+    // Numero de valores que deben quedar en o bajo el percentil.
+    std::size_t target = std::ceil(percentile / 100 * this->total_count);
+    if (target == 0)
+    {
+        target = 1;
+    }
+
+    std::size_t seen = 0;
+    for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+    {
+        seen += this->counts[bucket];
+
+        if (seen >= target)
+        {
+            std::size_t value = highest_value_of(bucket);
+            return (value < this->max_value) ? value : this->max_value;
+        }
+    }
+
+    return this->max_value;
+}
+
+std::size_t LatencyHistogram::get_total_count()
+{
+    return this->total_count;
+}
+
+std::size_t LatencyHistogram::get_max_value()
+{
+    return this->max_value;
+}
+
+std::size_t LatencyHistogram::highest_value_of(std::size_t bucket)
+{
+    if (bucket < 2 * LATENCY_SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    // Inverso de bucket_of: bucket = shift * SUB_BUCKETS + (value >> shift).
+    std::size_t shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    std::size_t sub_bucket = bucket - shift * LATENCY_SUB_BUCKETS;
+
+    return ((sub_bucket + 1) << shift) - 1;
+}
@@ -3,29 +3,240 @@
  * de la etapa 2 del proyecto.
  */
 
+#include "../model/access_ring.h"
 #include "../model/arguments.h"
 #include "../model/cache.h"
+#include "../model/compressed_cache.h"
+#include "../model/fast_cache.h"
+#include "../model/perf_counters.h"
+#include "../model/sampler.h"
+#include "../model/trace_analyzer.h"
+#include "../model/trace_parser.h"
 
 #include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <fcntl.h>
+#include <fstream>
 #include <iostream>
+#include <sched.h>
+#include <sstream>
 #include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+// Numero de registros del anillo en memoria compartida.
+#define ACCESS_RING_CAPACITY (1 << 20)
+// Numero de accesos que se sacan del anillo o del socket a la vez.
+#define ACCESS_BATCH_SIZE 4096
+
+/**
+ * Componentes que participan en la simulacion de cada acceso.
+ */
+struct Simulation
+{
+    // Cache de datos, o unificada si no hay cache de instrucciones.
+    Cache* cache;
+    // Cache L1I que recibe los ifetch, o nullptr si la cache es unificada.
+    Cache* instruction_cache;
+    // Muestreo de la cache de datos, o nullptr si se simulan todos los accesos.
+    Sampler* sampler;
+    // Caracterizacion de la traza, o nullptr si no se analiza.
+    TraceAnalyzer* analyzer;
+    // Motor optimizado que se compara con la cache en cada acceso,
+    // o nullptr si no se valida.
+    FastCache* validator;
+    // Referencias comparadas, y si ya hubo una diferencia.
+    std::size_t validated_count;
+    bool diverged;
+    // Modelos sombra de la cache de datos con y sin compresion, o nullptr
+    // si no se evalua la compresion.
+    CompressedCache* compressed;
+    CompressedCache* uncompressed;
+    // Accesos recibidos de la traza, el anillo o el socket.
+    std::size_t reference_count;
+    // Referencias de calentamiento que faltan, si se simula solo la
+    // region de interes y si la traza esta dentro de ella, y cuantas
+    // referencias solo calentaron la cache.
+    std::size_t warmup_remaining;
+    bool roi;
+    bool in_roi;
+    std::size_t warmed_count;
+};
+
+/**
+ * Valor del archivo de resultados.
+ */
+struct ResultField
+{
+    std::string name;
+    std::string value;
+    // Si es true el valor es texto; si no, un numero.
+    bool text;
+};
+
+/**
+ * Lee la traza de la entrada estandar, la analiza por bloques en paralelo
+ * e invoca al metodo para acceder a la cache con cada acceso, en orden.
+ * 
+ * @param simulation    Caches, muestreo y analisis que reciben cada acceso.
+ * @param thread_count  Numero de hilos que analizan la traza.
+ */
+void read_trace_file(Simulation* simulation, std::size_t thread_count);
+
+/**
+ * Lee la traza completa sin simularla y guarda sus accesos en @a accesses.
+ * Se usa en el modo --perf para medir por separado el analisis de la traza.
+ * 
+ * @param accesses      Arreglo donde se agregan los accesos de la traza.
+ * @param markers       Arreglo donde se agregan las marcas de la region
+ * de interes, con el numero de accesos que las preceden.
+ * @param thread_count  Numero de hilos que analizan la traza.
+ */
+void parse_trace_file(std::vector<Access>* accesses,
+                      std::vector<std::pair<std::size_t, int> >* markers,
+                      std::size_t thread_count);
+
+/**
+ * Crea el anillo en memoria compartida @a name y simula los accesos
+ * que el productor le agrega, hasta que el productor lo cierre.
+ * 
+ * @param simulation    Caches, muestreo y analisis que reciben cada acceso.
+ * @param name          Nombre del objeto de memoria compartida.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int read_access_ring(Simulation* simulation, const char* name);
+
+/**
+ * Espera una conexion en el socket Unix @a path y simula los registros
+ * AccessRecord que recibe, hasta que el productor cierre la conexion.
+ * 
+ * @param simulation    Caches, muestreo y analisis que reciben cada acceso.
+ * @param path          Ruta del socket.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int read_access_socket(Simulation* simulation, const char* path);
+
+/**
+ * Simula un acceso, a traves del muestreo si esta activo. Los ifetch van
+ * a la cache de instrucciones si existe; si no, a la cache unificada.
+ * 
+ * @param simulation    Caches, muestreo y analisis que reciben el acceso.
+ * @param access        Acceso por simular.
+ */
+void simulate_access(Simulation* simulation, Access access);
 
 /**
- * Lee cada linea del archivo de la traza e invoca al metodo
- * para acceder a la cache.
+ * Actualiza el estado de las caches y de los modelos sombra con @a access
+ * sin contarlo, imprimirlo ni medir su latencia. Se usa con las
+ * referencias de calentamiento y fuera de la region de interes.
  * 
- * @param cache Objeto de la clase Cache que maneja cada acceso a cache/memoria.
+ * @param simulation    Caches que reciben el acceso.
+ * @param access        Acceso por simular.
  */
-void read_trace_file(Cache* cache);
+void warm_access(Simulation* simulation, Access access);
+
+/**
+ * Aplica una marca TRACE_ROI_BEGIN o TRACE_ROI_END de la traza.
+ * 
+ * @param simulation    Simulacion que entra o sale de la region de interes.
+ * @param marker        Marca de la traza.
+ */
+void apply_marker(Simulation* simulation, int marker);
+
+/**
+ * Simula @a access en la cache y en el motor optimizado y compara los
+ * resultados. En la primera diferencia imprime el acceso, ambos
+ * resultados y el estado del conjunto en los dos motores, y marca la
+ * simulacion para que no siga.
+ * 
+ * @param simulation    Cache de referencia y motor optimizado.
+ * @param access        Acceso por simular.
+ */
+void validate_access(Simulation* simulation, Access access);
 
 /**
  * Imprime el estado final de la cache despues de leer
  * cada linea del archivo de la traza.
  * 
- * @param cache Objeto de la clase Cache que maneja cada acceso a cache/memoria.
+ * @param simulation    Caches simuladas y muestreo con sus estimaciones.
+ */
+void print_cache_results(Simulation* simulation);
+
+/**
+ * Imprime los contadores de las operaciones ifetch, prefetch y flush
+ * de @a cache que tengan referencias.
+ * 
+ * @param cache     Objeto de la clase Cache con los contadores.
+ */
+void print_operation_results(Cache* cache);
+
+/**
+ * Imprime los hits, misses y desalojos de cada tenant de @a cache, si
+ * tiene mascaras de vias o si la traza trae tenants distintos de 0.
+ * 
+ * @param cache     Objeto de la clase Cache con los contadores.
+ */
+void print_tenant_results(Cache* cache);
+
+/**
+ * Imprime los percentiles de latencia de los loads y de los stores
+ * de @a cache que tengan referencias.
+ * 
+ * @param cache     Objeto de la clase Cache con los histogramas.
+ */
+void print_latency_results(Cache* cache);
+
+/**
+ * Imprime los misses de la cache comprimida y de la cache sin comprimir
+ * con la misma geometria, y la capacidad efectiva que da la compresion.
+ * 
+ * @param compressed    Modelo con compresion.
+ * @param uncompressed  Modelo sin compresion.
+ */
+void print_compression_results(CompressedCache* compressed,
+                               CompressedCache* uncompressed);
+
+/**
+ * Escribe la configuracion y los resultados de la simulacion en el
+ * archivo cache_data->results_path, como un objeto JSON o como un
+ * encabezado y una fila de CSV.
+ * 
+ * @param simulation    Caches simuladas y numero de referencias.
+ * @param cache_data    Datos de la cache y opciones del programa.
+ * @param seconds       Tiempo real que tomo la simulacion.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
  */
-void print_cache_results(Cache* cache);
+int write_results_file(Simulation* simulation, CacheData* cache_data,
+                       double seconds);
+
+/**
+ * Imprime lo que midieron los contadores de una fase del simulador.
+ * 
+ * @param phase     Nombre de la fase.
+ * @param counters  Contadores de la fase.
+ */
+void print_perf_report(const char* phase, PerfCounters* counters);
+
+/**
+ * Imprime la caracterizacion de la traza.
+ * 
+ * @param analyzer  Objeto de la clase TraceAnalyzer con los resultados.
+ */
+void print_trace_analysis(TraceAnalyzer* analyzer);
+
+/**
+ * Lee los accesos del origen configurado, los simula e imprime
+ * los resultados.
+ * 
+ * @param cache_data    Datos de la cache y opciones del programa.
+ * @param cache         Objeto de la clase Cache que maneja cada acceso a cache/memoria.
+ * @return 0 si no hubo error; de lo contrario, el codigo de error.
+ */
+int run_simulation(CacheData* cache_data, Cache* cache);
 
 /**
  * Comienza la ejecucion del programa.
@@ -39,75 +250,567 @@ int main(int argc, char* argv[])
 
     srand(time(NULL));
 
-    CacheData* cache_data = new CacheData();
+    CacheData cache_data = CacheData();
+    error = analyze_arguments(argc, argv, &cache_data);
+
+    if (error == 0 && cache_data.trace_path != nullptr)
+    {
+        // La traza se sigue leyendo de la entrada estandar.
+        int file = open(cache_data.trace_path, O_RDONLY);
+
+        if (file < 0 || dup2(file, STDIN_FILENO) < 0)
+        {
+            std::cerr << "Error: Could not open trace file "
+                      << cache_data.trace_path << '\n';
+            error = 29;
+        }
+        if (file >= 0)
+        {
+            close(file);
+        }
+    }
+
+    if (error == 0)
+    {
+        Cache cache(&cache_data);
+
+        if (cache.is_valid())
+        {
+            error = run_simulation(&cache_data, &cache);
+        }
+        else
+        {
+            std::cerr << "Error: Could not create cache\n";
+            error = 12;
+        }
+    }
+
+    return error;
+}
+
+int run_simulation(CacheData* cache_data, Cache* cache)
+{
+    int error = 0;
+    Simulation simulation;
+    simulation.cache = cache;
+    simulation.instruction_cache = nullptr;
+    simulation.sampler = nullptr;
+    simulation.analyzer = nullptr;
+    simulation.validator = nullptr;
+    simulation.validated_count = 0;
+    simulation.diverged = false;
+    simulation.compressed = nullptr;
+    simulation.uncompressed = nullptr;
+    simulation.reference_count = 0;
+    simulation.warmup_remaining = cache_data->warmup;
+    simulation.roi = cache_data->roi;
+    simulation.in_roi = false;
+    simulation.warmed_count = 0;
+
+    if (cache_data->sampling != NO_SAMPLING)
+    {
+        simulation.sampler = new Sampler(cache, cache_data);
+    }
+
+    if (cache_data->analyze_window > 0)
+    {
+        simulation.analyzer = new TraceAnalyzer(cache_data);
+    }
+
+    if (cache_data->validate)
+    {
+        simulation.validator = new FastCache(cache_data);
+    }
+
+    if (cache_data->compress)
+    {
+        simulation.compressed = new CompressedCache(cache_data, true);
+        simulation.uncompressed = new CompressedCache(cache_data, false);
+    }
+
+    if (cache_data->icache_sets > 0)
+    {
+        // La L1I comparte el tamano de bloque y los ciclos con la cache
+        // de datos, pero accesa la memoria con los ciclos fijos y sin
+        // victim cache ni MSHRs. Usa la misma traduccion que la cache de
+        // datos, para que una pagina tenga el mismo marco en ambas.
+        CacheData icache_data = *cache_data;
+        icache_data.num_of_sets = cache_data->icache_sets;
+        icache_data.num_of_set_blocks = cache_data->icache_set_blocks;
+        icache_data.mshr_count = 0;
+        icache_data.victim_entries = 0;
+        icache_data.dram_channels = 0;
+        icache_data.tlb_entries = 0;
+
+        simulation.instruction_cache = new Cache(&icache_data);
+
+        if (!(simulation.instruction_cache->is_valid()))
+        {
+            std::cerr << "Error: Could not create instruction cache\n";
+            error = 12;
+        }
+        else if (cache->get_translator() != nullptr)
+        {
+            simulation.instruction_cache->share_translator(cache->get_translator());
+        }
+    }
+
+    PerfCounters* parse_counters = nullptr;
+    PerfCounters* simulate_counters = nullptr;
+
+    if (cache_data->perf)
+    {
+        parse_counters = new PerfCounters();
+        simulate_counters = new PerfCounters();
+    }
+
+    timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
 
-    if (cache_data != nullptr)
+    // Sin traza de texto no hay fase de analisis: se mide todo
+    // como simulacion.
+    if (cache_data->perf && cache_data->input_source != TRACE_INPUT)
     {
-        error = analyze_arguments(argc, argv, cache_data);
+        simulate_counters->start();
+    }
 
-        if (error == 0)
+    switch ((error == 0) ? cache_data->input_source : -1)
+    {
+    case SHM_INPUT:
+        error = read_access_ring(&simulation, cache_data->input_name);
+        break;
+    case SOCKET_INPUT:
+        error = read_access_socket(&simulation, cache_data->input_name);
+        break;
+    case TRACE_INPUT:
+        if (cache_data->perf)
         {
-            Cache* cache = new Cache(cache_data);
+            // Analizar toda la traza antes de simular para medir
+            // cada fase por separado.
+            std::vector<Access> accesses;
+            std::vector<std::pair<std::size_t, int> > markers;
+            std::size_t marker = 0;
+
+            parse_counters->start();
+            parse_trace_file(&accesses, &markers, cache_data->parse_threads);
+            parse_counters->stop();
 
-            if (cache != nullptr)
+            simulate_counters->start();
+            for (std::size_t index = 0; index < accesses.size()
+                 && !(simulation.diverged); ++index)
             {
-                read_trace_file(cache);
+                for (; marker < markers.size() && markers[marker].first == index;
+                     ++marker)
+                {
+                    apply_marker(&simulation, markers[marker].second);
+                }
+                simulate_access(&simulation, accesses[index]);
+            }
+            simulate_counters->stop();
+        }
+        else
+        {
+            read_trace_file(&simulation, cache_data->parse_threads);
+        }
+        break;
+    }
+
+    if (cache_data->perf && cache_data->input_source != TRACE_INPUT)
+    {
+        simulate_counters->stop();
+    }
+
+    timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    double seconds = (end_time.tv_sec - start_time.tv_sec)
+                     + (end_time.tv_nsec - start_time.tv_nsec) / 1e9;
+
+    if (simulation.sampler != nullptr)
+    {
+        simulation.sampler->finish();
+    }
+
+    if (simulation.analyzer != nullptr)
+    {
+        simulation.analyzer->finish();
+    }
+
+    if (simulation.diverged)
+    {
+        error = 27;
+    }
+
+    if (error == 0)
+    {
+        std::cout << '\n';
+        print_cache_results(&simulation);
 
-                std::cout << '\n';
-                print_cache_results(cache);
-                
-                delete cache;
+        if (cache_data->perf)
+        {
+            std::cout << '\n';
+            print_perf_report("parse", parse_counters);
+            print_perf_report("simulate", simulate_counters);
+        }
+
+        if (simulation.analyzer != nullptr)
+        {
+            std::cout << '\n';
+            print_trace_analysis(simulation.analyzer);
+        }
+
+        if (simulation.compressed != nullptr)
+        {
+            std::cout << '\n';
+            print_compression_results(simulation.compressed, simulation.uncompressed);
+        }
+
+        if (simulation.validator != nullptr)
+        {
+            std::cout << "\nValidation: FastCache matched Cache in "
+                      << simulation.validated_count << " references\n";
+        }
+
+        if (cache_data->results_path != nullptr)
+        {
+            error = write_results_file(&simulation, cache_data, seconds);
+        }
+    }
+
+    delete simulate_counters;
+    delete parse_counters;
+    delete simulation.uncompressed;
+    delete simulation.compressed;
+    delete simulation.validator;
+    delete simulation.instruction_cache;
+    delete simulation.analyzer;
+    delete simulation.sampler;
+
+    return error;
+}
+
+void read_trace_file(Simulation* simulation, std::size_t thread_count)
+{
+    TraceParser parser(STDIN_FILENO, thread_count);
+    TraceChunk* chunk = nullptr;
+
+    while ((chunk = parser.next_chunk()) != nullptr)
+    {
+        std::size_t error = 0;
+        std::size_t marker = 0;
+
+        // Los errores se reportan y las marcas se aplican entre los
+        // accesos que los rodean.
+        for (std::size_t index = 0; index <= chunk->accesses.size(); ++index)
+        {
+            for (; error < chunk->errors.size() && chunk->errors[error].first == index;
+                 ++error)
+            {
+                std::cerr << "Syntax error in line #" << chunk->errors[error].second
+                          << "\n";
             }
-            else
+
+            for (; marker < chunk->markers.size()
+                 && chunk->markers[marker].first == index; ++marker)
             {
-                std::cerr << "Error: Could not create cache\n";
-                error = 12;
+                apply_marker(simulation, chunk->markers[marker].second);
             }
+
+            if (index < chunk->accesses.size())
+            {
+                simulate_access(simulation, chunk->accesses[index]);
+            }
+        }
+
+        parser.release_chunk(chunk);
+
+        if (simulation->diverged)
+        {
+            break;
         }
-        
-        delete cache_data;
     }
-    else
+}
+
+void parse_trace_file(std::vector<Access>* accesses,
+                      std::vector<std::pair<std::size_t, int> >* markers,
+                      std::size_t thread_count)
+{
+    TraceParser parser(STDIN_FILENO, thread_count);
+    TraceChunk* chunk = nullptr;
+
+    while ((chunk = parser.next_chunk()) != nullptr)
+    {
+        for (std::size_t error = 0; error < chunk->errors.size(); ++error)
+        {
+            std::cerr << "Syntax error in line #" << chunk->errors[error].second << "\n";
+        }
+
+        for (std::size_t marker = 0; marker < chunk->markers.size(); ++marker)
+        {
+            markers->push_back(std::make_pair(accesses->size()
+                                              + chunk->markers[marker].first,
+                                              chunk->markers[marker].second));
+        }
+
+        accesses->insert(accesses->end(), chunk->accesses.begin(),
+                         chunk->accesses.end());
+        parser.release_chunk(chunk);
+    }
+}
+
+int read_access_ring(Simulation* simulation, const char* name)
+{
+    AccessRing* ring = AccessRing::create(name, ACCESS_RING_CAPACITY);
+
+    if (ring == nullptr)
+    {
+        std::cerr << "Error: Could not create shared memory ring " << name << '\n';
+        return 16;
+    }
+
+    Access batch[ACCESS_BATCH_SIZE];
+    std::size_t record_counter = 0;
+    int error = 0;
+    bool reading = true;
+
+    while (reading)
     {
-        std::cerr << "Error: Could not allocate cache data\n";
-        error = 11;
+        std::size_t count = ring->pop(batch, ACCESS_BATCH_SIZE);
+
+        if (count == 0)
+        {
+            // Solo se termina si el anillo sigue vacio despues del cierre.
+            if (ring->is_closed())
+            {
+                count = ring->pop(batch, ACCESS_BATCH_SIZE);
+                reading = (count > 0);
+            }
+            else
+            {
+                sched_yield();
+            }
+        }
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            ++record_counter;
+
+            // El productor puede escribir cualquier byte en el registro.
+            if (!(Cache::is_valid_operation(batch[index].operation))
+                || batch[index].tenant >= MAX_TENANTS)
+            {
+                std::cerr << "Invalid access record #" << record_counter << "\n";
+                error = 32;
+            }
+            else
+            {
+                simulate_access(simulation, batch[index]);
+            }
+        }
     }
 
+    delete ring;
     return error;
 }
 
-void read_trace_file(Cache* cache)
+int read_access_socket(Simulation* simulation, const char* path)
 {
-    Access access;
-    std::string current_line;
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        std::cerr << "Error: Socket path is too long\n";
+        return 17;
+    }
+    strcpy(address.sun_path, path);
 
-    std::size_t line_counter = 0;
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path);
 
-    while (std::getline(std::cin, current_line))
+    if (server < 0 || bind(server, (sockaddr*) &address, sizeof(address)) != 0
+        || listen(server, 1) != 0)
     {
-        ++line_counter;
-        if (current_line.substr(0, 2) == "//")
+        std::cerr << "Error: Could not listen on socket " << path << '\n';
+        if (server >= 0)
         {
-            // Comment.
+            close(server);
         }
-        else if ((sscanf(current_line.c_str(), "%c %lx",
-                &access.operation, &access.address) != 2)
-                || (access.operation != LOAD && access.operation != STORE)
-                || (access.address > 0xffffffff))
+        return 17;
+    }
+
+    int client = accept(server, nullptr, nullptr);
+    AccessRecord records[ACCESS_BATCH_SIZE];
+    std::size_t pending = 0;
+    std::size_t record_counter = 0;
+    int error = 0;
+    ssize_t received = 0;
+
+    while (client >= 0
+           && (received = read(client, (char*) records + pending,
+                               sizeof(records) - pending)) > 0)
+    {
+        pending += received;
+        std::size_t count = pending / sizeof(AccessRecord);
+
+        for (std::size_t index = 0; index < count; ++index)
         {
-            std::cerr << "Syntax error in line #" << line_counter << "\n";
+            Access access;
+            access.operation = records[index].operation;
+            access.tenant = records[index].tenant;
+            access.has_value = false;
+            access.value = 0;
+            access.address = records[index].address;
+            ++record_counter;
+
+            if (!(Cache::is_valid_operation(access.operation))
+                || access.tenant >= MAX_TENANTS)
+            {
+                std::cerr << "Invalid access record #" << record_counter << "\n";
+                error = 32;
+            }
+            else
+            {
+                simulate_access(simulation, access);
+            }
         }
-        else
+
+        // Conservar el registro incompleto para la siguiente lectura.
+        pending -= count * sizeof(AccessRecord);
+        memmove(records, records + count, pending);
+    }
+
+    if (client >= 0)
+    {
+        close(client);
+    }
+    close(server);
+    unlink(path);
+
+    return error;
+}
+
+void simulate_access(Simulation* simulation, Access access)
+{
+    if (simulation->diverged)
+    {
+        return;
+    }
+
+    ++simulation->reference_count;
+
+    if (simulation->warmup_remaining > 0
+        || (simulation->roi && !(simulation->in_roi)))
+    {
+        if (simulation->warmup_remaining > 0)
         {
-            printf("%c 0x%08lx ", access.operation, access.address);
+            --simulation->warmup_remaining;
+        }
+        warm_access(simulation, access);
+        return;
+    }
+
+    if (simulation->analyzer != nullptr)
+    {
+        simulation->analyzer->handle_reference(access);
+    }
+
+    // Los modelos de compresion reciben todos los accesos de la cache
+    // de datos, aun con muestreo.
+    if (simulation->compressed != nullptr
+        && !(access.operation == IFETCH && simulation->instruction_cache != nullptr))
+    {
+        simulation->compressed->handle_reference(access);
+        simulation->uncompressed->handle_reference(access);
+    }
 
-            cache->handle_reference(access);
+    // El muestreo solo aplica a la cache de datos.
+    if (access.operation == IFETCH && simulation->instruction_cache != nullptr)
+    {
+        simulation->instruction_cache->handle_reference(access);
+    }
+    else if (simulation->sampler != nullptr)
+    {
+        simulation->sampler->handle_reference(access);
+    }
+    else if (simulation->validator != nullptr)
+    {
+        validate_access(simulation, access);
+    }
+    else
+    {
+        simulation->cache->handle_reference(access);
+    }
+}
+
+void warm_access(Simulation* simulation, Access access)
+{
+    ++simulation->warmed_count;
+
+    if (simulation->compressed != nullptr
+        && !(access.operation == IFETCH && simulation->instruction_cache != nullptr))
+    {
+        simulation->compressed->warm_reference(access);
+        simulation->uncompressed->warm_reference(access);
+    }
+
+    if (access.operation == IFETCH && simulation->instruction_cache != nullptr)
+    {
+        simulation->instruction_cache->warm_reference(access);
+    }
+    else
+    {
+        simulation->cache->warm_reference(access);
+
+        if (simulation->validator != nullptr)
+        {
+            simulation->validator->warm_reference(access);
         }
     }
 }
 
-void print_cache_results(Cache* cache)
+void apply_marker(Simulation* simulation, int marker)
+{
+    simulation->in_roi = (marker == TRACE_ROI_BEGIN);
+}
+
+void validate_access(Simulation* simulation, Access access)
 {
+    Cache* cache = simulation->cache;
+    FastCache* validator = simulation->validator;
+
+    AccessResult expected = cache->handle_reference(access);
+    AccessResult actual = validator->handle_reference(access);
+    ++simulation->validated_count;
+
+    if (expected.hit != actual.hit || expected.cycles != actual.cycles
+        || cache->get_eviction_count() != validator->get_eviction_count())
+    {
+        std::size_t index = cache->get_index(access.address);
+
+        printf("\nValidation failed at reference #%zu: %c 0x%08lx (set %zu)\n",
+               simulation->validated_count, access.operation, access.address, index);
+        printf("Cache:     %s, %zu cycles, %zu evictions\n",
+               expected.hit ? "hit" : "miss", expected.cycles,
+               cache->get_eviction_count());
+        printf("FastCache: %s, %zu cycles, %zu evictions\n",
+               actual.hit ? "hit" : "miss", actual.cycles,
+               validator->get_eviction_count());
+        printf("Cache set state:\n");
+        cache->print_set(index);
+        printf("FastCache set state:\n");
+        validator->print_set(index);
+
+        simulation->diverged = true;
+    }
+}
+
+void print_cache_results(Simulation* simulation)
+{
+    Cache* cache = simulation->cache;
+    Cache* instruction_cache = simulation->instruction_cache;
+    Sampler* sampler = simulation->sampler;
+
     std::cout << "Total loads: " << cache->get_load_count() << '\n';
     std::cout << "Total stores: " << cache->get_store_count() << '\n';
     std::cout << "Load hits: " << cache->get_load_hit_count() << '\n';
@@ -116,4 +819,463 @@ void print_cache_results(Cache* cache)
     std::cout << "Store misses: " << cache->get_store_miss_count() << '\n';
     std::cout << "Evictions: " << cache->get_eviction_count() << '\n';
     std::cout << "Total CPU Cycles: " << cache->get_total_cpu_cycles() << '\n';
-}
\ No newline at end of file
+    print_operation_results(cache);
+    print_tenant_results(cache);
+    print_latency_results(cache);
+
+    if (simulation->warmed_count > 0)
+    {
+        std::cout << "Warm-up references (not counted): "
+                  << simulation->warmed_count << '\n';
+    }
+
+    AddressTranslator* translator = cache->get_translator();
+
+    if (translator != nullptr)
+    {
+        std::cout << "TLB L1 hits: " << translator->get_l1_hit_count() << '\n';
+        std::cout << "TLB L2 hits: " << translator->get_l2_hit_count() << '\n';
+        std::cout << "Page walks: " << translator->get_page_walk_count() << '\n';
+        std::cout << "Translation cycles: " << translator->get_translation_cycles()
+                  << '\n';
+    }
+
+    DramModel* dram = cache->get_dram();
+
+    if (dram != nullptr)
+    {
+        std::size_t requests = dram->get_request_count();
+        std::cout << "DRAM requests: " << requests << '\n';
+        std::cout << "DRAM row hit rate: "
+                  << ((requests > 0) ? (double) dram->get_row_hit_count() / requests : 0)
+                  << '\n';
+        std::cout << "DRAM row conflicts: " << dram->get_row_conflict_count() << '\n';
+        std::cout << "DRAM bandwidth (bytes/cycle): " << dram->get_bandwidth() << '\n';
+    }
+
+    if (cache->has_victim_cache())
+    {
+        std::cout << "Victim cache hits: " << cache->get_victim_hit_count() << '\n';
+    }
+
+    if (cache->is_non_blocking())
+    {
+        std::cout << "MSHR merged accesses: " << cache->get_mshr_merge_count() << '\n';
+        std::cout << "MSHR stall cycles: " << cache->get_mshr_stall_cycles() << '\n';
+    }
+
+    if (sampler != nullptr)
+    {
+        std::cout << "\nSampled references: " << sampler->get_sampled_reference_count()
+                  << " of " << sampler->get_total_reference_count()
+                  << " (" << sampler->get_unit_count() << " sample units)\n";
+        printf("Estimated hit rate: %.4f +/- %.4f (95%% CI)\n",
+               sampler->get_hit_rate(), sampler->get_hit_rate_margin());
+        printf("Estimated total CPU Cycles: %.0f +/- %.0f (95%% CI)\n",
+               sampler->get_total_cpu_cycles(),
+               sampler->get_total_cpu_cycles_margin());
+    }
+
+    if (instruction_cache != nullptr)
+    {
+        std::cout << "\nInstruction cache\n";
+        print_operation_results(instruction_cache);
+        std::cout << "Instruction cache evictions: "
+                  << instruction_cache->get_eviction_count() << '\n';
+        std::cout << "Instruction cache CPU Cycles: "
+                  << instruction_cache->get_total_cpu_cycles() << '\n';
+    }
+}
+
+void print_operation_results(Cache* cache)
+{
+    if (cache->get_ifetch_hit_count() + cache->get_ifetch_miss_count() > 0)
+    {
+        std::cout << "Ifetch hits: " << cache->get_ifetch_hit_count() << '\n';
+        std::cout << "Ifetch misses: " << cache->get_ifetch_miss_count() << '\n';
+    }
+
+    if (cache->get_prefetch_hit_count() + cache->get_prefetch_miss_count() > 0)
+    {
+        std::cout << "Prefetch hits: " << cache->get_prefetch_hit_count() << '\n';
+        std::cout << "Prefetch misses: " << cache->get_prefetch_miss_count() << '\n';
+    }
+
+    if (cache->get_flush_count() > 0)
+    {
+        std::cout << "Flushes: " << cache->get_flush_count()
+                  << " (" << cache->get_flush_hit_count() << " present, "
+                  << cache->get_writeback_count() << " written back)\n";
+    }
+
+    if (cache->is_sectored())
+    {
+        std::cout << "Sector misses: " << cache->get_sector_miss_count()
+                  << " (" << cache->get_sector_count() << " sectors per block)\n";
+        std::cout << "Memory traffic: " << cache->get_read_bytes() << " bytes read, "
+                  << cache->get_write_bytes() << " bytes written\n";
+    }
+}
+
+void print_tenant_results(Cache* cache)
+{
+    bool tenants = cache->is_partitioned();
+
+    for (std::size_t tenant = 1; tenant < MAX_TENANTS && !(tenants); ++tenant)
+    {
+        tenants = (cache->get_tenant_hit_count(tenant)
+                   + cache->get_tenant_miss_count(tenant) > 0);
+    }
+
+    if (!(tenants))
+    {
+        return;
+    }
+
+    for (std::size_t tenant = 0; tenant < MAX_TENANTS; ++tenant)
+    {
+        std::size_t hits = cache->get_tenant_hit_count(tenant);
+        std::size_t misses = cache->get_tenant_miss_count(tenant);
+
+        if (hits + misses > 0)
+        {
+            printf("Tenant %zu (ways 0x%zx): %zu hits, %zu misses, %zu evictions, "
+                   "hit rate %.4f\n", tenant, cache->get_way_mask(tenant), hits,
+                   misses, cache->get_tenant_eviction_count(tenant),
+                   (double) hits / (hits + misses));
+        }
+    }
+}
+
+void print_latency_results(Cache* cache)
+{
+    const char* names[] = {"Load", "Store"};
+    LatencyHistogram* histograms[] = {cache->get_load_latency(),
+                                      cache->get_store_latency()};
+
+    for (std::size_t index = 0; index < 2; ++index)
+    {
+        LatencyHistogram* histogram = histograms[index];
+
+        if (histogram->get_total_count() > 0)
+        {
+            printf("%s latency (cycles): p50 %zu, p90 %zu, p99 %zu, p99.9 %zu, "
+                   "max %zu\n", names[index], histogram->get_percentile(50),
+                   histogram->get_percentile(90), histogram->get_percentile(99),
+                   histogram->get_percentile(99.9), histogram->get_max_value());
+        }
+    }
+}
+
+void print_compression_results(CompressedCache* compressed,
+                               CompressedCache* uncompressed)
+{
+    std::size_t misses = compressed->get_miss_count();
+    std::size_t base_misses = uncompressed->get_miss_count();
+    std::size_t capacity = compressed->get_capacity_lines();
+    double resident = compressed->get_average_resident_lines();
+    double base_resident = uncompressed->get_average_resident_lines();
+
+    printf("Compressed cache (BDI, LRU): %zu hits, %zu misses, %zu evictions\n",
+           compressed->get_hit_count(), misses, compressed->get_eviction_count());
+    printf("Uncompressed cache (LRU): %zu hits, %zu misses, %zu evictions\n",
+           uncompressed->get_hit_count(), base_misses,
+           uncompressed->get_eviction_count());
+    printf("Miss reduction: %.2f%%\n", (base_misses > 0)
+           ? 100.0 * ((double) base_misses - misses) / base_misses : 0);
+    printf("Average compressed line: %.2f bytes (%zu zero lines)\n",
+           compressed->get_average_line_bytes(), compressed->get_zero_line_count());
+    printf("Effective capacity: %.2f lines of %zu (gain %.2fx)\n",
+           resident, capacity, (base_resident > 0) ? resident / base_resident : 0);
+}
+
+int write_results_file(Simulation* simulation, CacheData* cache_data,
+                       double seconds)
+{
+    const char* replacements[] = {"lru", "fifo", "random"};
+    Cache* cache = simulation->cache;
+    Sampler* sampler = simulation->sampler;
+    std::vector<ResultField> fields;
+
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    ResultField field;
+    field.text = true;
+    field.name = "write_policy_1";
+    field.value = cache_data->write_allocate ? "write-allocate" : "no-write-allocate";
+    fields.push_back(field);
+    field.name = "write_policy_2";
+    field.value = cache_data->write_through ? "write-through" : "write-back";
+    fields.push_back(field);
+    field.name = "replacement";
+    field.value = replacements[cache_data->replacement];
+    fields.push_back(field);
+    field.name = "trace";
+    field.value = (cache_data->trace_path != nullptr) ? cache_data->trace_path : "-";
+    fields.push_back(field);
+
+    // Las referencias de calentamiento no cuentan como simuladas.
+    std::size_t references = simulation->reference_count - simulation->warmed_count;
+    std::vector<std::pair<const char*, std::size_t> > counts = {
+        {"num_of_sets", cache_data->num_of_sets},
+        {"num_of_set_blocks", cache_data->num_of_set_blocks},
+        {"num_of_block_bytes", cache_data->num_of_block_bytes},
+        {"cache_access_cycles", cache_data->cache_access_cycles},
+        {"memory_access_cycles", cache_data->memory_access_cycles},
+        {"references", references},
+        {"warmup_references", simulation->warmed_count}
+    };
+
+    // Con muestreo los contadores de la cache solo cubren la muestra, asi
+    // que se escriben las estimaciones del muestreo, como en la salida.
+    if (sampler == nullptr)
+    {
+        counts.push_back({"load_hits", cache->get_load_hit_count()});
+        counts.push_back({"load_misses", cache->get_load_miss_count()});
+        counts.push_back({"store_hits", cache->get_store_hit_count()});
+        counts.push_back({"store_misses", cache->get_store_miss_count()});
+        counts.push_back({"evictions", cache->get_eviction_count()});
+        counts.push_back({"total_cpu_cycles", cache->get_total_cpu_cycles()});
+    }
+    else
+    {
+        counts.push_back({"sampled_references", sampler->get_sampled_reference_count()});
+        counts.push_back({"sample_units", sampler->get_unit_count()});
+    }
+
+    LatencyHistogram* latencies[] = {cache->get_load_latency(), cache->get_store_latency()};
+    const char* latency_names[][5] = {
+        {"load_latency_p50", "load_latency_p90", "load_latency_p99",
+         "load_latency_p99_9", "load_latency_max"},
+        {"store_latency_p50", "store_latency_p90", "store_latency_p99",
+         "store_latency_p99_9", "store_latency_max"}
+    };
+
+    for (int kind = 0; kind < 2; ++kind)
+    {
+        counts.push_back({latency_names[kind][0], latencies[kind]->get_percentile(50)});
+        counts.push_back({latency_names[kind][1], latencies[kind]->get_percentile(90)});
+        counts.push_back({latency_names[kind][2], latencies[kind]->get_percentile(99)});
+        counts.push_back({latency_names[kind][3], latencies[kind]->get_percentile(99.9)});
+        counts.push_back({latency_names[kind][4], latencies[kind]->get_max_value()});
+    }
+    counts.push_back({"peak_rss_kb", (std::size_t) usage.ru_maxrss});
+
+    field.text = false;
+    for (std::size_t index = 0; index < counts.size(); ++index)
+    {
+        field.name = counts[index].first;
+        field.value = std::to_string(counts[index].second);
+        fields.push_back(field);
+    }
+
+    std::ostringstream number;
+    number << std::fixed;
+
+    if (sampler != nullptr)
+    {
+        std::pair<const char*, double> estimates[] = {
+            {"estimated_hit_rate", sampler->get_hit_rate()},
+            {"estimated_hit_rate_margin", sampler->get_hit_rate_margin()},
+            {"estimated_total_cpu_cycles", sampler->get_total_cpu_cycles()},
+            {"estimated_total_cpu_cycles_margin",
+             sampler->get_total_cpu_cycles_margin()}
+        };
+
+        for (std::size_t index = 0; index < 4; ++index)
+        {
+            number.str("");
+            number << estimates[index].second;
+            field.name = estimates[index].first;
+            field.value = number.str();
+            fields.push_back(field);
+        }
+    }
+
+    number.str("");
+    number << seconds;
+    field.name = "runtime_seconds";
+    field.value = number.str();
+    fields.push_back(field);
+
+    // El rendimiento incluye las referencias de calentamiento, que
+    // tambien se procesaron.
+    number.str("");
+    number << ((seconds > 0) ? simulation->reference_count / seconds : 0);
+    field.name = "references_per_second";
+    field.value = number.str();
+    fields.push_back(field);
+
+    std::ofstream file(cache_data->results_path);
+
+    if (cache_data->results_format == RESULTS_CSV)
+    {
+        for (std::size_t index = 0; index < fields.size(); ++index)
+        {
+            file << (index > 0 ? "," : "") << fields[index].name;
+        }
+        file << '\n';
+
+        for (std::size_t index = 0; index < fields.size(); ++index)
+        {
+            std::string value = fields[index].value;
+
+            // El texto va entre comillas y sus comillas se duplican.
+            if (fields[index].text)
+            {
+                for (std::size_t quote = value.find('"'); quote != std::string::npos;
+                     quote = value.find('"', quote + 2))
+                {
+                    value.insert(quote, 1, '"');
+                }
+                value = '"' + value + '"';
+            }
+            file << (index > 0 ? "," : "") << value;
+        }
+        file << '\n';
+    }
+    else
+    {
+        file << "{\n";
+        for (std::size_t index = 0; index < fields.size(); ++index)
+        {
+            std::string value = fields[index].value;
+
+            if (fields[index].text)
+            {
+                std::string escaped;
+                for (std::size_t character = 0; character < value.size(); ++character)
+                {
+                    unsigned char code = value[character];
+
+                    if (code == '"' || code == '\\')
+                    {
+                        escaped += '\\';
+                        escaped += value[character];
+                    }
+                    // JSON no permite caracteres de control dentro del texto.
+                    else if (code < 0x20)
+                    {
+                        char sequence[8];
+                        snprintf(sequence, sizeof(sequence), "\\u%04x", code);
+                        escaped += sequence;
+                    }
+                    else
+                    {
+                        escaped += value[character];
+                    }
+                }
+                value = '"' + escaped + '"';
+            }
+            file << "  \"" << fields[index].name << "\": " << value
+                 << (index + 1 < fields.size() ? ",\n" : "\n");
+        }
+        file << "}\n";
+    }
+
+    if (!(file))
+    {
+        std::cerr << "Error: Could not write results file "
+                  << cache_data->results_path << '\n';
+        return 30;
+    }
+
+    return 0;
+}
+
+void print_perf_report(const char* phase, PerfCounters* counters)
+{
+    printf("Phase %s: %.3f ms wall time", phase, counters->get_wall_seconds() * 1000);
+
+    if (counters->is_available())
+    {
+        double cycles = counters->get_value(PERF_CYCLES);
+        double instructions = counters->get_value(PERF_INSTRUCTIONS);
+
+        printf(", %.0f cycles, %.0f instructions, %.2f IPC, "
+               "%llu LLC misses, %llu branch misses\n",
+               cycles, instructions, (cycles > 0) ? instructions / cycles : 0,
+               (unsigned long long) counters->get_value(PERF_LLC_MISSES),
+               (unsigned long long) counters->get_value(PERF_BRANCH_MISSES));
+    }
+    else
+    {
+        printf(" (hardware counters unavailable)\n");
+    }
+}
+
+void print_trace_analysis(TraceAnalyzer* analyzer)
+{
+    std::size_t references = analyzer->get_reference_count();
+    std::size_t block_bytes = analyzer->get_block_bytes();
+    double unique_lines = analyzer->get_unique_line_count();
+
+    printf("Trace analysis (%zu-byte blocks)\n", block_bytes);
+    printf("References: %zu (%zu loads, %zu stores, load/store ratio %.2f)\n",
+           references, analyzer->get_load_count(), analyzer->get_store_count(),
+           (analyzer->get_store_count() > 0)
+           ? (double) analyzer->get_load_count() / analyzer->get_store_count() : 0);
+    printf("Unique blocks: %.0f (%.0f bytes)\n", unique_lines,
+           unique_lines * block_bytes);
+    printf("Working set per %zu references: %.0f average, %.0f min, "
+           "%.0f max blocks in %zu windows\n",
+           analyzer->get_window(), analyzer->get_window_average(),
+           analyzer->get_window_min(), analyzer->get_window_max(),
+           analyzer->get_window_count());
+
+    printf("\nReuse distance in blocks (%zu sampled references, rate %.4f):\n",
+           analyzer->get_sampled_reference_count(), analyzer->get_sampling_rate());
+    for (std::size_t bucket = 0; bucket < REUSE_BUCKETS; ++bucket)
+    {
+        double fraction = analyzer->get_reuse_fraction(bucket);
+
+        if (fraction > 0)
+        {
+            if (bucket == 0)
+            {
+                printf("  0: %.4f\n", fraction);
+            }
+            else
+            {
+                printf("  [%zu, %zu]: %.4f\n", (std::size_t) 1 << (bucket - 1),
+                       ((std::size_t) 1 << bucket) - 1, fraction);
+            }
+        }
+    }
+    printf("  cold: %.4f\n", analyzer->get_cold_fraction());
+    printf("Fully-associative LRU miss ratio with %zu blocks: %.4f\n",
+           analyzer->get_cache_lines(), analyzer->get_lru_miss_ratio());
+
+    printf("\nStride between consecutive references in blocks:\n");
+    for (std::size_t bucket = 0; bucket < STRIDE_BUCKETS; ++bucket)
+    {
+        for (int negative = 0; negative < 2; ++negative)
+        {
+            std::size_t count = analyzer->get_stride_count(bucket, negative);
+            char sign = negative ? '-' : '+';
+
+            if (count == 0 || (bucket == 0 && negative))
+            {
+                continue;
+            }
+
+            double fraction = (double) count / (references - 1);
+
+            if (bucket == 0)
+            {
+                printf("  0: %zu (%.4f)\n", count, fraction);
+            }
+            else if (bucket == 1)
+            {
+                printf("  %c1: %zu (%.4f)\n", sign, count, fraction);
+            }
+            else
+            {
+                printf("  %c[%zu, %zu]: %zu (%.4f)\n", sign,
+                       (std::size_t) 1 << (bucket - 1),
+                       ((std::size_t) 1 << bucket) - 1, count, fraction);
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * Codigo fuente de la clase MissTiming.
+ */
+
+#include "../model/miss_timing.h"
+
+MissTiming::MissTiming(std::size_t entry_count, std::size_t window_size,
+                       Arena* arena) :
+    entries(arena->allocate<MissEntry>(entry_count)),
+    entry_count(entry_count),
+    window(arena->allocate<std::size_t>(window_size)),
+    window_size(window_size)
+{
+    this->reset();
+}
+
+std::size_t MissTiming::required_bytes(std::size_t entry_count,
+                                       std::size_t window_size)
+{
+    return Arena::bytes_for<MissTiming>(1)
+           + Arena::bytes_for<MissEntry>(entry_count)
+           + Arena::bytes_for<std::size_t>(window_size);
+}
+
+void MissTiming::reset()
+{
+    for (std::size_t entry = 0; entry < this->entry_count; ++entry)
+    {
+        this->entries[entry].line = 0;
+        this->entries[entry].completion_cycle = 0;
+    }
+
+    for (std::size_t slot = 0; slot < this->window_size; ++slot)
+    {
+        this->window[slot] = 0;
+    }
+
+    this->access_count = 0;
+    this->next_issue_cycle = 0;
+    this->finish_cycle = 0;
+    this->merge_count = 0;
+    this->stall_cycles = 0;
+}
+
+std::size_t MissTiming::add_access(std::size_t line, bool hit, std::size_t latency)
+{
+    // No se puede emitir hasta que termine la referencia que ocupaba
+    // este mismo espacio de la ventana.
+    std::size_t slot = this->access_count % this->window_size;
+    std::size_t issue_cycle = this->next_issue_cycle;
+
+    if (this->window[slot] > issue_cycle)
+    {
+        issue_cycle = this->window[slot];
+    }
+
+    MissEntry* pending = nullptr;
+    MissEntry* earliest = &this->entries[0];
+
+    for (std::size_t entry = 0; entry < this->entry_count; ++entry)
+    {
+        if (this->entries[entry].completion_cycle > issue_cycle
+            && this->entries[entry].line == line)
+        {
+            pending = &this->entries[entry];
+        }
+        if (this->entries[entry].completion_cycle < earliest->completion_cycle)
+        {
+            earliest = &this->entries[entry];
+        }
+    }
+
+    std::size_t completion_cycle = 0;
+
+    if (pending != nullptr)
+    {
+        // El bloque sigue en camino: esperar al MSHR que ya lo pidio.
+        completion_cycle = issue_cycle + latency;
+        if (pending->completion_cycle > completion_cycle)
+        {
+            completion_cycle = pending->completion_cycle;
+        }
+        ++this->merge_count;
+    }
+    else if (!(hit))
+    {
+        // Si todos los MSHRs estan ocupados, esperar al primero que se libere.
+        if (earliest->completion_cycle > issue_cycle)
+        {
+            this->stall_cycles += earliest->completion_cycle - issue_cycle;
+            issue_cycle = earliest->completion_cycle;
+        }
+
+        completion_cycle = issue_cycle + latency;
+        earliest->line = line;
+        earliest->completion_cycle = completion_cycle;
+    }
+    else
+    {
+        completion_cycle = issue_cycle + latency;
+    }
+
+    this->window[slot] = completion_cycle;
+    this->next_issue_cycle = issue_cycle + 1;
+    ++this->access_count;
+
+    if (completion_cycle > this->finish_cycle)
+    {
+        this->finish_cycle = completion_cycle;
+    }
+
+    return this->finish_cycle;
+}
+
+std::size_t MissTiming::get_merge_count()
+{
+    return this->merge_count;
+}
+
+std::size_t MissTiming::get_stall_cycles()
+{
+    return this->stall_cycles;
+}
@@ -0,0 +1,120 @@
+/**
+ * Codigo fuente de la clase PerfCounters.
+ */
+
+#include "../model/perf_counters.h"
+
+#include <cstring>
+#include <ctime>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Retorna el tiempo del reloj monotonico en segundos.
+ */
+static double monotonic_seconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+PerfCounters::PerfCounters() :
+    available(true),
+    wall_seconds(0),
+    start_seconds(0)
+{
+    const std::uint64_t configs[PERF_COUNTER_COUNT] =
+    {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter)
+    {
+        perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = configs[counter];
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        // Cuenta tambien los hilos que se creen despues, como los
+        // analizadores de la traza.
+        attributes.inherit = 1;
+
+        this->values[counter] = 0;
+        this->descriptors[counter] = syscall(__NR_perf_event_open, &attributes,
+                                             0, -1, -1, 0);
+
+        if (this->descriptors[counter] < 0)
+        {
+            this->available = false;
+        }
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter)
+    {
+        if (this->descriptors[counter] >= 0)
+        {
+            close(this->descriptors[counter]);
+        }
+    }
+}
+
+void PerfCounters::start()
+{
+    if (this->available)
+    {
+        for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter)
+        {
+            ioctl(this->descriptors[counter], PERF_EVENT_IOC_RESET, 0);
+            ioctl(this->descriptors[counter], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    this->start_seconds = monotonic_seconds();
+}
+
+void PerfCounters::stop()
+{
+    this->wall_seconds += monotonic_seconds() - this->start_seconds;
+
+    if (this->available)
+    {
+        for (int counter = 0; counter < PERF_COUNTER_COUNT; ++counter)
+        {
+            std::uint64_t value = 0;
+            ioctl(this->descriptors[counter], PERF_EVENT_IOC_DISABLE, 0);
+
+            if (read(this->descriptors[counter], &value, sizeof(value))
+                == (ssize_t) sizeof(value))
+            {
+                this->values[counter] += value;
+            }
+        }
+    }
+}
+
+bool PerfCounters::is_available()
+{
+    return this->available;
+}
+
+double PerfCounters::get_wall_seconds()
+{
+    return this->wall_seconds;
+}
+
+std::uint64_t PerfCounters::get_value(int counter)
+{
+    return this->values[counter];
+}
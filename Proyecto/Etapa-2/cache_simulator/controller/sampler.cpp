@@ -0,0 +1,205 @@
+/**
+ * Codigo fuente de la clase Sampler.
+ */
+
+#include "../model/sampler.h"
+
+#include <cmath>
+
+// Valor z para un intervalo de confianza del 95%.
+#define CONFIDENCE_Z 1.96
+
+Sampler::Sampler(Cache* cache, CacheData* cache_data) :
+    cache(cache),
+    mode(cache_data->sampling),
+    ratio(cache_data->sampling_ratio),
+    period(cache_data->sampling_period),
+    window(cache_data->sampling_window),
+    total_reference_count(0),
+    sampled_reference_count(0),
+    units(nullptr),
+    unit_count(0)
+{
+    if (this->mode == SET_SAMPLING)
+    {
+        this->unit_count = cache_data->num_of_sets / this->ratio;
+    }
+    else
+    {
+        this->unit_count = 1;
+    }
+
+    this->units = new SampleUnit[this->unit_count];
+
+    for (std::size_t unit = 0; unit < this->unit_count; ++unit)
+    {
+        this->units[unit].reference_count = 0;
+        this->units[unit].hit_count = 0;
+        this->units[unit].cycle_count = 0;
+    }
+
+    this->sums.unit_count = 0;
+    this->sums.references = 0;
+    this->sums.references_squared = 0;
+    this->sums.hits = 0;
+    this->sums.hits_squared = 0;
+    this->sums.references_hits = 0;
+    this->sums.cycles = 0;
+    this->sums.cycles_squared = 0;
+    this->sums.references_cycles = 0;
+}
+
+Sampler::~Sampler()
+{
+    delete [] this->units;
+}
+
+void Sampler::handle_reference(Access reference)
+{
+    SampleUnit* unit = nullptr;
+
+    if (this->mode == SET_SAMPLING)
+    {
+        std::size_t index = this->cache->get_index(reference.address);
+
+        // Los conjuntos no muestreados se descartan por completo.
+        if (index % this->ratio == 0)
+        {
+            unit = &this->units[index / this->ratio];
+        }
+    }
+    else if (this->total_reference_count % this->period < this->window)
+    {
+        unit = &this->units[0];
+    }
+    else
+    {
+        // Fuera de la ventana detallada solo se calienta la cache.
+        this->cache->warm_reference(reference);
+    }
+
+    ++this->total_reference_count;
+
+    if (unit != nullptr)
+    {
+        AccessResult result = this->cache->handle_reference(reference);
+
+        ++this->sampled_reference_count;
+        ++unit->reference_count;
+        unit->hit_count += result.hit;
+        unit->cycle_count += result.cycles;
+
+        // Al terminar una ventana detallada se cierra su unidad.
+        if (this->mode == TIME_SAMPLING
+            && unit->reference_count == this->window)
+        {
+            this->add_unit(unit);
+        }
+    }
+}
+
+void Sampler::finish()
+{
+    for (std::size_t unit = 0; unit < this->unit_count; ++unit)
+    {
+        // En time sampling solo queda pendiente una ventana parcial.
+        if (this->mode == SET_SAMPLING || this->units[unit].reference_count > 0)
+        {
+            this->add_unit(&this->units[unit]);
+        }
+    }
+}
+
+std::size_t Sampler::get_total_reference_count()
+{
+    return this->total_reference_count;
+}
+
+std::size_t Sampler::get_sampled_reference_count()
+{
+    return this->sampled_reference_count;
+}
+
+std::size_t Sampler::get_unit_count()
+{
+    return this->sums.unit_count;
+}
+
+double Sampler::get_hit_rate()
+{
+    return (this->sums.references > 0) ? this->sums.hits / this->sums.references : 0;
+}
+
+double Sampler::get_hit_rate_margin()
+{
+    return this->ratio_margin(this->sums.hits, this->sums.hits_squared,
+                              this->sums.references_hits);
+}
+
+double Sampler::get_total_cpu_cycles()
+{
+    double cycles_per_reference = (this->sums.references > 0)
+        ? this->sums.cycles / this->sums.references : 0;
+
+    return cycles_per_reference * this->total_reference_count;
+}
+
+double Sampler::get_total_cpu_cycles_margin()
+{
+    return this->ratio_margin(this->sums.cycles, this->sums.cycles_squared,
+                              this->sums.references_cycles)
+           * this->total_reference_count;
+}
+
+void Sampler::add_unit(SampleUnit* unit)
+{
+    double references = unit->reference_count;
+    double hits = unit->hit_count;
+    double cycles = unit->cycle_count;
+
+    this->sums.unit_count += 1;
+    this->sums.references += references;
+    this->sums.references_squared += references * references;
+    this->sums.hits += hits;
+    this->sums.hits_squared += hits * hits;
+    this->sums.references_hits += references * hits;
+    this->sums.cycles += cycles;
+    this->sums.cycles_squared += cycles * cycles;
+    this->sums.references_cycles += references * cycles;
+
+    unit->reference_count = 0;
+    unit->hit_count = 0;
+    unit->cycle_count = 0;
+}
+
+double Sampler::ratio_margin(double value, double value_squared,
+                             double references_value)
+{
+    double n = this->sums.unit_count;
+
+    if (n < 2 || this->sums.references <= 0)
+    {
+        return 0;
+    }
+
+    // Total de unidades en la poblacion, para la correccion por poblacion finita.
+    // En time sampling la poblacion son todas las ventanas posibles de la traza.
+    double population = (this->mode == SET_SAMPLING)
+        ? n * this->ratio
+        : std::ceil((double) this->total_reference_count / this->window);
+
+    double ratio = value / this->sums.references;
+    double mean_references = this->sums.references / n;
+
+    // Varianza muestral de los residuos y_i - R * x_i.
+    double residual_variance = (value_squared
+                                - 2 * ratio * references_value
+                                + ratio * ratio * this->sums.references_squared)
+                               / (n - 1);
+
+    double correction = (population > n) ? (1 - n / population) : 0;
+    double variance = correction * residual_variance
+                      / (n * mean_references * mean_references);
+
+    return CONFIDENCE_Z * std::sqrt((variance > 0) ? variance : 0);
+}
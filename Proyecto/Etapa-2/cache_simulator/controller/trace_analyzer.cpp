@@ -0,0 +1,389 @@
+/**
+ * Codigo fuente de la clase TraceAnalyzer.
+ */
+
+#include "../model/trace_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Modulo del hash que decide el muestreo de la distancia de reuso.
+#define SHARDS_MODULUS (1 << 24)
+
+// Posicion que ya no corresponde al ultimo acceso de un bloque.
+#define INVALID_LINE ((std::size_t) -1)
+
+/**
+ * Mezcla los bits de @a value (finalizador de splitmix64) para que
+ * los bloques cercanos tengan hashes independientes.
+ */
+static std::uint64_t hash_line(std::uint64_t value)
+{
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+TraceAnalyzer::TraceAnalyzer(CacheData* cache_data) :
+    offset_bits(log2(cache_data->num_of_block_bytes)),
+    cache_lines(cache_data->num_of_sets * cache_data->num_of_set_blocks),
+    reference_count(0),
+    load_count(0),
+    store_count(0),
+    threshold(SHARDS_MODULUS),
+    sampled_reference_count(0),
+    slot_lines(4 * ANALYSIS_MAX_LINES, INVALID_LINE),
+    slot_tree(4 * ANALYSIS_MAX_LINES + 1, 0),
+    next_slot(0),
+    cold_weight(0),
+    lru_miss_weight(0),
+    total_weight(0),
+    window(cache_data->analyze_window),
+    window_reference_count(0),
+    window_count(0),
+    window_sum(0),
+    window_min(0),
+    window_max(0),
+    has_previous(false),
+    previous_line(0)
+{
+    for (std::size_t bucket = 0; bucket < REUSE_BUCKETS; ++bucket)
+    {
+        this->reuse_weights[bucket] = 0;
+    }
+
+    memset(this->total_registers, 0, sizeof(this->total_registers));
+    memset(this->window_registers, 0, sizeof(this->window_registers));
+    memset(this->positive_strides, 0, sizeof(this->positive_strides));
+    memset(this->negative_strides, 0, sizeof(this->negative_strides));
+
+    this->last_slot.reserve(2 * ANALYSIS_MAX_LINES);
+}
+
+void TraceAnalyzer::handle_reference(Access reference)
+{
+    std::size_t line = reference.address >> this->offset_bits;
+    std::uint64_t hash = hash_line(line);
+
+    ++this->reference_count;
+    if (reference.operation == LOAD)
+    {
+        ++this->load_count;
+    }
+    else if (reference.operation == STORE)
+    {
+        ++this->store_count;
+    }
+
+    if (this->has_previous)
+    {
+        if (line >= this->previous_line)
+        {
+            ++this->positive_strides[bucket_of(line - this->previous_line)];
+        }
+        else
+        {
+            ++this->negative_strides[bucket_of(this->previous_line - line)];
+        }
+    }
+    this->has_previous = true;
+    this->previous_line = line;
+
+    this->update_reuse(line, hash);
+
+    add_hash(this->total_registers, hash);
+    add_hash(this->window_registers, hash);
+
+    if (++this->window_reference_count == this->window)
+    {
+        this->close_window();
+    }
+}
+
+void TraceAnalyzer::finish()
+{
+    if (this->window_reference_count > 0)
+    {
+        this->close_window();
+    }
+}
+
+void TraceAnalyzer::update_reuse(std::size_t line, std::uint64_t hash)
+{
+    std::uint32_t line_hash = hash % SHARDS_MODULUS;
+
+    if (line_hash >= this->threshold)
+    {
+        return;
+    }
+
+    // Cada referencia muestreada representa 1 / tasa referencias,
+    // y cada bloque seguido representa 1 / tasa bloques.
+    double scale = (double) SHARDS_MODULUS / this->threshold;
+    std::unordered_map<std::size_t, std::size_t>::iterator found =
+        this->last_slot.find(line);
+
+    ++this->sampled_reference_count;
+    this->total_weight += scale;
+
+    if (found == this->last_slot.end())
+    {
+        this->cold_weight += scale;
+        this->lru_miss_weight += scale;
+        this->tracked.insert(std::make_pair(line_hash, line));
+    }
+    else
+    {
+        // Bloques distintos accesados despues del ultimo acceso a este.
+        std::size_t slot = found->second;
+        std::size_t newer = this->last_slot.size() - this->count_slots(slot);
+        double distance = newer * scale;
+
+        this->reuse_weights[bucket_of((std::size_t) distance)] += scale;
+        if (distance >= this->cache_lines)
+        {
+            this->lru_miss_weight += scale;
+        }
+
+        this->add_slot(slot, -1);
+        this->slot_lines[slot] = INVALID_LINE;
+    }
+
+    if (this->next_slot == this->slot_lines.size())
+    {
+        this->compact_slots();
+    }
+
+    this->last_slot[line] = this->next_slot;
+    this->slot_lines[this->next_slot] = line;
+    this->add_slot(this->next_slot, 1);
+    ++this->next_slot;
+
+    if (this->tracked.size() > ANALYSIS_MAX_LINES)
+    {
+        this->lower_threshold();
+    }
+}
+
+void TraceAnalyzer::lower_threshold()
+{
+    this->threshold = this->tracked.rbegin()->first;
+
+    while (!(this->tracked.empty())
+           && this->tracked.rbegin()->first >= this->threshold)
+    {
+        std::size_t line = this->tracked.rbegin()->second;
+        std::size_t slot = this->last_slot[line];
+
+        this->add_slot(slot, -1);
+        this->slot_lines[slot] = INVALID_LINE;
+        this->last_slot.erase(line);
+        this->tracked.erase(--this->tracked.end());
+    }
+}
+
+void TraceAnalyzer::compact_slots()
+{
+    std::size_t next = 0;
+
+    std::fill(this->slot_tree.begin(), this->slot_tree.end(), 0);
+
+    for (std::size_t slot = 0; slot < this->slot_lines.size(); ++slot)
+    {
+        std::size_t line = this->slot_lines[slot];
+
+        if (line != INVALID_LINE)
+        {
+            this->slot_lines[slot] = INVALID_LINE;
+            this->slot_lines[next] = line;
+            this->last_slot[line] = next;
+            this->add_slot(next, 1);
+            ++next;
+        }
+    }
+
+    this->next_slot = next;
+}
+
+void TraceAnalyzer::add_slot(std::size_t slot, long delta)
+{
+    for (std::size_t node = slot + 1; node < this->slot_tree.size();
+         node += node & (~node + 1))
+    {
+        this->slot_tree[node] += delta;
+    }
+}
+
+std::size_t TraceAnalyzer::count_slots(std::size_t slot)
+{
+    std::size_t count = 0;
+
+    for (std::size_t node = slot + 1; node > 0; node -= node & (~node + 1))
+    {
+        count += this->slot_tree[node];
+    }
+
+    return count;
+}
+
+void TraceAnalyzer::close_window()
+{
+    double lines = estimate(this->window_registers);
+
+    if (this->window_count == 0 || lines < this->window_min)
+    {
+        this->window_min = lines;
+    }
+    if (this->window_count == 0 || lines > this->window_max)
+    {
+        this->window_max = lines;
+    }
+
+    this->window_sum += lines;
+    ++this->window_count;
+    this->window_reference_count = 0;
+    memset(this->window_registers, 0, sizeof(this->window_registers));
+}
+
+void TraceAnalyzer::add_hash(std::uint8_t* registers, std::uint64_t hash)
+{
+    std::size_t index = hash >> (64 - HLL_PRECISION);
+    std::uint64_t rest = hash << HLL_PRECISION;
+    std::uint8_t rank = (rest == 0) ? (64 - HLL_PRECISION + 1)
+                                    : (__builtin_clzll(rest) + 1);
+
+    if (rank > registers[index])
+    {
+        registers[index] = rank;
+    }
+}
+
+double TraceAnalyzer::estimate(const std::uint8_t* registers)
+{
+    const double count = 1 << HLL_PRECISION;
+    double sum = 0;
+    std::size_t zeros = 0;
+
+    for (std::size_t index = 0; index < (1 << HLL_PRECISION); ++index)
+    {
+        sum += ldexp(1.0, -registers[index]);
+        if (registers[index] == 0)
+        {
+            ++zeros;
+        }
+    }
+
+    double alpha = 0.7213 / (1 + 1.079 / count);
+    double result = alpha * count * count / sum;
+
+    // Con pocos elementos el conteo lineal es mas preciso.
+    if (result <= 2.5 * count && zeros > 0)
+    {
+        result = count * log(count / zeros);
+    }
+
+    return result;
+}
+
+std::size_t TraceAnalyzer::bucket_of(std::size_t value)
+{
+    std::size_t bucket = 0;
+
+    while (value > 0 && bucket < REUSE_BUCKETS - 1)
+    {
+        value >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+std::size_t TraceAnalyzer::get_block_bytes()
+{
+    return (std::size_t) 1 << this->offset_bits;
+}
+
+std::size_t TraceAnalyzer::get_cache_lines()
+{
+    return this->cache_lines;
+}
+
+std::size_t TraceAnalyzer::get_reference_count()
+{
+    return this->reference_count;
+}
+
+std::size_t TraceAnalyzer::get_load_count()
+{
+    return this->load_count;
+}
+
+std::size_t TraceAnalyzer::get_store_count()
+{
+    return this->store_count;
+}
+
+double TraceAnalyzer::get_unique_line_count()
+{
+    return estimate(this->total_registers);
+}
+
+std::size_t TraceAnalyzer::get_window()
+{
+    return this->window;
+}
+
+std::size_t TraceAnalyzer::get_window_count()
+{
+    return this->window_count;
+}
+
+double TraceAnalyzer::get_window_average()
+{
+    return (this->window_count > 0) ? this->window_sum / this->window_count : 0;
+}
+
+double TraceAnalyzer::get_window_min()
+{
+    return this->window_min;
+}
+
+double TraceAnalyzer::get_window_max()
+{
+    return this->window_max;
+}
+
+double TraceAnalyzer::get_sampling_rate()
+{
+    return (double) this->threshold / SHARDS_MODULUS;
+}
+
+std::size_t TraceAnalyzer::get_sampled_reference_count()
+{
+    return this->sampled_reference_count;
+}
+
+double TraceAnalyzer::get_reuse_fraction(std::size_t bucket)
+{
+    return (this->total_weight > 0)
+           ? this->reuse_weights[bucket] / this->total_weight : 0;
+}
+
+double TraceAnalyzer::get_cold_fraction()
+{
+    return (this->total_weight > 0) ? this->cold_weight / this->total_weight : 0;
+}
+
+double TraceAnalyzer::get_lru_miss_ratio()
+{
+    return (this->total_weight > 0)
+           ? this->lru_miss_weight / this->total_weight : 0;
+}
+
+std::size_t TraceAnalyzer::get_stride_count(std::size_t bucket, bool negative)
+{
+    return negative ? this->negative_strides[bucket]
+                    : this->positive_strides[bucket];
+}
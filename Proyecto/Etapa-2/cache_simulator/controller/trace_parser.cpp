@@ -0,0 +1,332 @@
+/**
+ * Codigo fuente de la clase TraceParser.
+ */
+
+#include "../model/trace_parser.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+// Estados de un bloque en el anillo.
+#define CHUNK_EMPTY     0
+#define CHUNK_READ      1
+#define CHUNK_PARSING   2
+#define CHUNK_PARSED    3
+
+TraceParser::TraceParser(int file, std::size_t thread_count) :
+    file(file),
+    next_read(0),
+    next_parse(0),
+    next_consume(0),
+    end_of_file(false),
+    stopping(false),
+    consumed_lines(0)
+{
+    if (thread_count == 0)
+    {
+        thread_count = default_thread_count();
+    }
+
+    // Dos bloques por analizador para que el lector y el consumidor
+    // no los hagan esperar.
+    this->chunks.resize(2 * thread_count + 2);
+    for (std::size_t index = 0; index < this->chunks.size(); ++index)
+    {
+        this->chunks[index].line_count = 0;
+        this->chunks[index].state = CHUNK_EMPTY;
+    }
+
+    this->reader = std::thread(&TraceParser::read_chunks, this);
+    for (std::size_t index = 0; index < thread_count; ++index)
+    {
+        this->parsers.push_back(std::thread(&TraceParser::parse_chunks, this));
+    }
+}
+
+TraceParser::~TraceParser()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->changed.notify_all();
+
+    this->reader.join();
+    for (std::size_t index = 0; index < this->parsers.size(); ++index)
+    {
+        this->parsers[index].join();
+    }
+}
+
+TraceChunk* TraceParser::next_chunk()
+{
+    std::unique_lock<std::mutex> lock(this->mutex);
+    TraceChunk* chunk = &this->chunks[this->next_consume % this->chunks.size()];
+
+    while (!(this->stopping)
+           && !(this->next_consume < this->next_read && chunk->state == CHUNK_PARSED)
+           && !(this->end_of_file && this->next_consume == this->next_read))
+    {
+        this->changed.wait(lock);
+    }
+
+    if (this->stopping || this->next_consume == this->next_read)
+    {
+        return nullptr;
+    }
+
+    // Los analizadores solo conocen las lineas de su bloque.
+    for (std::size_t index = 0; index < chunk->errors.size(); ++index)
+    {
+        chunk->errors[index].second += this->consumed_lines;
+    }
+    this->consumed_lines += chunk->line_count;
+    ++this->next_consume;
+
+    return chunk;
+}
+
+void TraceParser::release_chunk(TraceChunk* chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        chunk->state = CHUNK_EMPTY;
+    }
+    this->changed.notify_all();
+}
+
+int TraceParser::parse_line(const char* line, Access* access)
+{
+    if (strncmp(line, "//", 2) == 0)
+    {
+        char marker[16] = "";
+        char rest = '\0';
+
+        // Solo un comentario que tiene unicamente la marca cuenta como marca.
+        if (sscanf(line + 2, "%15s %c", marker, &rest) == 1)
+        {
+            if (strcmp(marker, "roi-begin") == 0)
+            {
+                return TRACE_ROI_BEGIN;
+            }
+            if (strcmp(marker, "roi-end") == 0)
+            {
+                return TRACE_ROI_END;
+            }
+        }
+
+        return TRACE_COMMENT;
+    }
+
+    int used = 0;
+    if ((sscanf(line, "%c %lx%n", &access->operation, &access->address, &used) < 2)
+        || !(Cache::is_valid_operation(access->operation))
+        || (access->address > 0xffffffff))
+    {
+        return TRACE_ERROR;
+    }
+
+    access->tenant = 0;
+    access->has_value = false;
+    access->value = 0;
+
+    // Despues de la direccion, el tenant va marcado con t= y el valor con
+    // v=. Como en la traza original, cualquier otra columna (por ejemplo,
+    // las instrucciones entre accesos) se ignora.
+    const char* column = line + used;
+    char text[32] = "";
+    int length = 0;
+
+    while (sscanf(column, "%31s%n", text, &length) == 1)
+    {
+        column += length;
+
+        unsigned tenant = 0;
+        std::size_t value = 0;
+        char rest = '\0';
+
+        if (strncmp(text, "t=", 2) == 0)
+        {
+            if ((sscanf(text + 2, "%u%c", &tenant, &rest) != 1)
+                || (tenant >= MAX_TENANTS))
+            {
+                return TRACE_ERROR;
+            }
+            access->tenant = tenant;
+        }
+        else if (strncmp(text, "v=", 2) == 0)
+        {
+            if ((sscanf(text + 2, "%lx%c", &value, &rest) != 1)
+                || (value > 0xffffffff))
+            {
+                return TRACE_ERROR;
+            }
+            access->has_value = true;
+            access->value = value;
+        }
+    }
+
+    return TRACE_ACCESS;
+}
+
+std::size_t TraceParser::default_thread_count()
+{
+    std::size_t count = std::thread::hardware_concurrency();
+    return (count > 0) ? count : 1;
+}
+
+void TraceParser::read_chunks()
+{
+    // Linea incompleta al final del bloque anterior.
+    std::vector<char> rest;
+    bool reading = true;
+
+    while (reading)
+    {
+        TraceChunk* chunk = &this->chunks[this->next_read % this->chunks.size()];
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            while (!(this->stopping) && chunk->state != CHUNK_EMPTY)
+            {
+                this->changed.wait(lock);
+            }
+
+            if (this->stopping)
+            {
+                return;
+            }
+        }
+
+        chunk->text.swap(rest);
+        rest.clear();
+
+        std::size_t used = chunk->text.size();
+        chunk->text.resize(used + TRACE_CHUNK_BYTES);
+
+        while (reading && used < chunk->text.size())
+        {
+            ssize_t received = read(this->file, &chunk->text[used],
+                                    chunk->text.size() - used);
+            if (received > 0)
+            {
+                used += received;
+            }
+            else if (received == 0 || errno != EINTR)
+            {
+                reading = false;
+            }
+        }
+        chunk->text.resize(used);
+
+        if (reading)
+        {
+            // El bloque termina en el ultimo cambio de linea y el resto
+            // pasa al siguiente. Una linea mas larga que el bloque se
+            // sigue leyendo en la siguiente vuelta.
+            std::size_t end = used;
+            while (end > 0 && chunk->text[end - 1] != '\n')
+            {
+                --end;
+            }
+
+            rest.assign(chunk->text.begin() + end, chunk->text.end());
+            chunk->text.resize(end);
+        }
+
+        if (!(chunk->text.empty()))
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            chunk->state = CHUNK_READ;
+            ++this->next_read;
+        }
+        this->changed.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->end_of_file = true;
+    }
+    this->changed.notify_all();
+}
+
+void TraceParser::parse_chunks()
+{
+    while (true)
+    {
+        TraceChunk* chunk = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            while (!(this->stopping) && this->next_parse == this->next_read
+                   && !(this->end_of_file))
+            {
+                this->changed.wait(lock);
+            }
+
+            if (this->stopping || this->next_parse == this->next_read)
+            {
+                return;
+            }
+
+            chunk = &this->chunks[this->next_parse % this->chunks.size()];
+            chunk->state = CHUNK_PARSING;
+            ++this->next_parse;
+        }
+
+        parse_chunk(chunk);
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            chunk->state = CHUNK_PARSED;
+        }
+        this->changed.notify_all();
+    }
+}
+
+void TraceParser::parse_chunk(TraceChunk* chunk)
+{
+    Access access;
+
+    chunk->accesses.clear();
+    chunk->errors.clear();
+    chunk->markers.clear();
+    chunk->line_count = 0;
+
+    // La ultima linea de la traza puede no tener cambio de linea.
+    if (chunk->text.back() != '\n')
+    {
+        chunk->text.push_back('\n');
+    }
+
+    char* line = &chunk->text[0];
+    char* end = line + chunk->text.size();
+
+    while (line < end)
+    {
+        char* newline = (char*) memchr(line, '\n', end - line);
+        *newline = '\0';
+        ++chunk->line_count;
+
+        int result = parse_line(line, &access);
+
+        switch (result)
+        {
+        case TRACE_ACCESS:
+            chunk->accesses.push_back(access);
+            break;
+        case TRACE_ROI_BEGIN:
+        case TRACE_ROI_END:
+            chunk->markers.push_back(std::make_pair(chunk->accesses.size(), result));
+            break;
+        case TRACE_ERROR:
+            chunk->errors.push_back(std::make_pair(chunk->accesses.size(),
+                                                   chunk->line_count));
+            break;
+        }
+
+        line = newline + 1;
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * Codigo fuente de la clase VictimCache.
+ */
+
+#include "../model/victim_cache.h"
+
+// Direccion que marca una entrada invalida.
+#define INVALID_LINE ((std::size_t) -1)
+
+VictimCache::VictimCache(std::size_t entry_count, Arena* arena) :
+    lines(arena->allocate<std::size_t>(entry_count)),
+    last_use(arena->allocate<std::size_t>(entry_count)),
+    entry_count(entry_count),
+    clock(0)
+{
+    this->reset();
+}
+
+std::size_t VictimCache::required_bytes(std::size_t entry_count)
+{
+    return Arena::bytes_for<VictimCache>(1)
+           + 2 * Arena::bytes_for<std::size_t>(entry_count);
+}
+
+void VictimCache::reset()
+{
+    for (std::size_t entry = 0; entry < this->entry_count; ++entry)
+    {
+        this->lines[entry] = INVALID_LINE;
+        this->last_use[entry] = 0;
+    }
+
+    this->clock = 0;
+}
+
+bool VictimCache::lookup(std::size_t line, bool remove)
+{
+    for (std::size_t entry = 0; entry < this->entry_count; ++entry)
+    {
+        if (this->lines[entry] == line)
+        {
+            if (remove)
+            {
+                this->lines[entry] = INVALID_LINE;
+                this->last_use[entry] = 0;
+            }
+            else
+            {
+                this->last_use[entry] = ++this->clock;
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void VictimCache::insert(std::size_t line)
+{
+    // Las entradas invalidas tienen last_use 0, asi que se eligen primero.
+    std::size_t victim = 0;
+
+    for (std::size_t entry = 1; entry < this->entry_count; ++entry)
+    {
+        if (this->last_use[entry] < this->last_use[victim])
+        {
+            victim = entry;
+        }
+    }
+
+    this->lines[victim] = line;
+    this->last_use[victim] = ++this->clock;
+}
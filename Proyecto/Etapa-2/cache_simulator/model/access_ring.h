@@ -0,0 +1,123 @@
+/**
+ * Encabezado de la clase AccessRing.
+ */
+
+#ifndef ACCESS_RING_H
+#define ACCESS_RING_H
+
+#include "cache.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Formato binario de un acceso en el anillo compartido y en el socket.
+ * Ocupa 8 bytes para que un productor pueda escribir muchos por linea.
+ */
+struct AccessRecord
+{
+    std::uint32_t address;
+    char operation;
+    unsigned char tenant;
+    char reserved[2];
+};
+
+/**
+ * Clase AccessRing.
+ * 
+ * Anillo de accesos en memoria compartida (POSIX shm) para un solo
+ * productor y un solo consumidor, sin candados. El simulador lo crea
+ * con create() y un proceso instrumentado se conecta con attach().
+ * Si el anillo esta lleno, push() espera a que el consumidor avance.
+ */
+class AccessRing
+{
+// Estructuras privadas
+private:
+    /**
+     * Encabezado al inicio de la memoria compartida. Los indices del
+     * productor y del consumidor van en lineas de cache distintas.
+     */
+    struct RingHeader
+    {
+        // Se publica al final de create() para que attach() vea el
+        // encabezado completo.
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t capacity;
+        alignas(64) std::atomic<std::size_t> head;
+        alignas(64) std::atomic<std::size_t> tail;
+        alignas(64) std::atomic<bool> closed;
+    };
+
+// Atributos privados
+private:
+    // Encabezado y registros mapeados.
+    RingHeader* header;
+    AccessRecord* records;
+    // capacity - 1, la capacidad siempre es potencia de 2.
+    std::size_t mask;
+    // Bytes mapeados en memoria.
+    std::size_t mapped_bytes;
+    // Nombre del objeto de memoria compartida, si este proceso lo creo.
+    char* owned_name;
+
+    // Copias locales del indice del otro extremo, para no leer
+    // la linea de cache compartida en cada operacion.
+    std::size_t cached_head;
+    std::size_t cached_tail;
+
+// Metodos publicos
+public:
+
+    /**
+     * Crea el objeto de memoria compartida @a name con espacio para
+     * @a capacity registros (potencia de 2).
+     * 
+     * @return El anillo creado, o nullptr si no se pudo crear.
+     */
+    static AccessRing* create(const char* name, std::size_t capacity);
+
+    /**
+     * Se conecta al anillo @a name creado por otro proceso.
+     * 
+     * @return El anillo, o nullptr si no existe o no es valido.
+     */
+    static AccessRing* attach(const char* name);
+
+    /**
+     * Desmapea el anillo. Si este proceso lo creo, tambien lo elimina.
+     */
+    ~AccessRing();
+
+    /**
+     * Agrega @a count accesos al anillo. Espera mientras este lleno.
+     * Solo lo debe invocar el productor.
+     */
+    void push(const Access* accesses, std::size_t count);
+
+    /**
+     * Saca hasta @a max_count accesos del anillo sin esperar.
+     * Solo lo debe invocar el consumidor.
+     * 
+     * @return El numero de accesos copiados en @a accesses.
+     */
+    std::size_t pop(Access* accesses, std::size_t max_count);
+
+    /**
+     * Indica que el productor ya no va a agregar mas accesos.
+     */
+    void close();
+
+    /**
+     * Retorna true si el productor cerro el anillo.
+     */
+    bool is_closed();
+
+// Metodos privados
+private:
+
+    AccessRing(void* memory, std::size_t mapped_bytes, const char* owned_name);
+};
+
+#endif /* ACCESS_RING_H */
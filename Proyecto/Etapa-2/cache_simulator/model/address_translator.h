@@ -0,0 +1,124 @@
+/**
+ * Encabezado de la clase AddressTranslator.
+ */
+
+#ifndef ADDRESS_TRANSLATOR_H
+#define ADDRESS_TRANSLATOR_H
+
+#include "arena.h"
+#include "arguments.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Clase AddressTranslator.
+ * 
+ * Traduce las direcciones virtuales de la traza a direcciones fisicas
+ * antes de accesar la cache. Simula un TLB de uno o dos niveles,
+ * set-associative con reemplazo LRU, el costo de recorrer la tabla de
+ * paginas en cada miss del TLB y una politica para asignar marcos
+ * fisicos a las paginas virtuales.
+ */
+class AddressTranslator
+{
+// Estructuras privadas
+private:
+    /**
+     * Estructura que representa una entrada de un TLB.
+     */
+    struct TlbEntry
+    {
+        std::size_t page;
+        std::size_t last_use;
+        bool valid;
+    };
+
+    /**
+     * Estructura que representa un nivel del TLB.
+     */
+    struct TlbLevel
+    {
+        TlbEntry* entries;
+        std::size_t num_of_sets;
+        std::size_t num_of_set_entries;
+        std::size_t access_cycles;
+        std::size_t hit_count;
+    };
+
+// Atributos privados
+private:
+    // Niveles del TLB. El segundo nivel es opcional.
+    TlbLevel levels[2];
+    std::size_t level_count;
+
+    // Numero de bits del offset dentro de una pagina.
+    std::size_t page_bits;
+    // Ciclos de cada recorrido de la tabla de paginas.
+    std::size_t page_walk_cycles;
+    // Politica de asignacion de marcos fisicos.
+    int page_mapping;
+
+    // Marco + 1 de cada pagina virtual, o 0 si no se ha accesado
+    // (solo con SEQUENTIAL_MAPPING), pagina de cada marco asignado, para
+    // limpiar solo esas entradas en reset(), y marcos ya asignados.
+    std::uint32_t* page_table;
+    std::uint32_t* frame_pages;
+    std::size_t mapped_page_count;
+
+    // Contador de usos para el reemplazo LRU.
+    std::size_t clock;
+
+    // Estadisticas.
+    std::size_t page_walk_count;
+    std::size_t translation_cycles;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye el traductor con los parametros de @a cache_data,
+     * con sus arreglos en @a arena.
+     */
+    AddressTranslator(CacheData* cache_data, Arena* arena);
+
+    /**
+     * Retorna los bytes de arena que necesita el traductor.
+     */
+    static std::size_t required_bytes(CacheData* cache_data);
+
+    /**
+     * Invalida los TLBs, olvida los marcos asignados y reinicia
+     * las estadisticas.
+     */
+    void reset();
+
+    /**
+     * Traduce la direccion virtual @a address a una direccion fisica.
+     * 
+     * @param address   Direccion virtual; recibe la direccion fisica.
+     * @param count     Si es false solo se actualiza el estado del TLB,
+     * sin incrementar las estadisticas.
+     * @return Los ciclos que tomo la traduccion.
+     */
+    std::size_t translate(std::size_t* address, bool count);
+
+    // Getters
+
+    std::size_t get_l1_hit_count();
+    std::size_t get_l2_hit_count();
+    std::size_t get_page_walk_count();
+    std::size_t get_translation_cycles();
+
+// Metodos privados
+private:
+
+    // Busca la pagina en un nivel del TLB y actualiza su uso.
+    bool lookup(TlbLevel* level, std::size_t page);
+    // Agrega la pagina a un nivel del TLB, reemplazando la entrada LRU.
+    void insert(TlbLevel* level, std::size_t page);
+    // Obtiene el marco fisico de una pagina virtual.
+    std::size_t map_page(std::size_t page);
+};
+
+#endif /* ADDRESS_TRANSLATOR_H */
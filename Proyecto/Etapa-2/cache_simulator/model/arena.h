@@ -0,0 +1,89 @@
+/**
+ * Encabezado de la clase Arena.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+
+// Alineamiento de cada arreglo dentro de la arena: una linea de cache.
+#define ARENA_ALIGNMENT 64
+
+/**
+ * Clase Arena.
+ * 
+ * Region de memoria reservada de una sola vez con mmap, de donde se
+ * sacan todos los arreglos de la cache. Si la region es grande intenta
+ * usar paginas enormes. Los arreglos no se liberan uno por uno: toda la
+ * region se libera al destruir la arena.
+ */
+class Arena
+{
+// Atributos privados
+private:
+    // Inicio de la region, o nullptr si no se pudo reservar.
+    char* memory;
+    // Bytes reservados y bytes ya asignados.
+    std::size_t capacity;
+    std::size_t used;
+    // Si la region esta respaldada por paginas enormes (MAP_HUGETLB).
+    bool huge_pages;
+
+// Metodos publicos
+public:
+
+    /**
+     * Reserva una region de @a capacity bytes.
+     */
+    Arena(std::size_t capacity);
+
+    /**
+     * Libera toda la region.
+     */
+    ~Arena();
+
+    // La region tiene un solo duenno.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * Asigna un arreglo de @a count elementos de tipo @a T, alineado
+     * a ARENA_ALIGNMENT. La memoria no se inicializa.
+     * 
+     * @return El arreglo, o nullptr si ya no hay espacio.
+     */
+    template <typename T>
+    T* allocate(std::size_t count)
+    {
+        std::size_t bytes = Arena::bytes_for<T>(count);
+
+        if (this->memory == nullptr || this->used + bytes > this->capacity)
+        {
+            return nullptr;
+        }
+
+        T* array = reinterpret_cast<T*>(this->memory + this->used);
+        this->used += bytes;
+
+        return array;
+    }
+
+    /**
+     * Retorna los bytes que ocupa en la arena un arreglo de @a count
+     * elementos de tipo @a T, incluyendo el relleno de alineamiento.
+     */
+    template <typename T>
+    static std::size_t bytes_for(std::size_t count)
+    {
+        std::size_t bytes = count * sizeof(T);
+        return (bytes + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    }
+
+    // Getters
+
+    bool is_valid();
+    bool uses_huge_pages();
+};
+
+#endif /* ARENA_H */
@@ -7,6 +7,24 @@
 
 #include <cstddef>
 
+#define NO_SAMPLING     0
+#define SET_SAMPLING    1
+#define TIME_SAMPLING   2
+
+#define IDENTITY_MAPPING    0
+#define SEQUENTIAL_MAPPING  1
+#define RANDOM_MAPPING      2
+
+// Numero maximo de tenants (clases de servicio) con mascara de vias.
+#define MAX_TENANTS 16
+
+#define RESULTS_JSON    0
+#define RESULTS_CSV     1
+
+#define TRACE_INPUT     0
+#define SHM_INPUT       1
+#define SOCKET_INPUT    2
+
 /**
  * Estructura que guarda informacion para inicializar
  * los atributos de la cache.
@@ -21,6 +39,109 @@ struct CacheData
     bool write_allocate;
     bool write_through;
     int replacement;
+
+    // Si es true no se imprime el resultado de cada acceso.
+    bool quiet;
+    // Si es true se miden las fases del simulador con contadores de hardware.
+    bool perf;
+
+    // Numero de MSHRs y tamano de la ventana fuera de orden del modelo
+    // de cache no bloqueante. Con 0 MSHRs la cache es bloqueante.
+    std::size_t mshr_count;
+    std::size_t mshr_window;
+
+    // Entradas y ciclos de acceso del victim cache (o miss cache si
+    // miss_cache es true) de la cache direct-mapped. 0 entradas lo desactiva.
+    std::size_t victim_entries;
+    std::size_t victim_access_cycles;
+    bool miss_cache;
+
+    // Entradas y asociatividad del TLB de primer nivel (0 entradas
+    // desactiva la traduccion) y del TLB de segundo nivel opcional.
+    std::size_t tlb_entries;
+    std::size_t tlb_ways;
+    std::size_t tlb2_entries;
+    std::size_t tlb2_ways;
+    std::size_t tlb2_access_cycles;
+    // Tamano de pagina, ciclos de cada recorrido de la tabla de paginas
+    // y politica de asignacion de marcos fisicos.
+    std::size_t page_size;
+    std::size_t page_walk_cycles;
+    int page_mapping;
+
+    // Modelo de la memoria principal: canales (0 lo desactiva), rangos,
+    // bancos por rango, bytes por fila, profundidad de la cola de cada
+    // canal, tiempos en ciclos y politica de pagina.
+    std::size_t dram_channels;
+    std::size_t dram_ranks;
+    std::size_t dram_banks;
+    std::size_t dram_row_bytes;
+    std::size_t dram_queue_depth;
+    std::size_t dram_t_rcd;
+    std::size_t dram_t_cas;
+    std::size_t dram_t_rp;
+    std::size_t dram_t_burst;
+    bool dram_closed_page;
+
+    // Conjuntos y bloques por conjunto de la cache L1I separada que
+    // recibe los ifetch. 0 conjuntos deja una sola cache unificada.
+    std::size_t icache_sets;
+    std::size_t icache_set_blocks;
+
+    // Sectores de cada bloque, cada uno con sus bits de valido y sucio.
+    // 0 desactiva los sectores y el conteo de trafico a memoria; 1 cuenta
+    // el trafico de bloques completos, para compararlo con el de sectores.
+    std::size_t sector_count;
+
+    // Referencias de cada ventana del conjunto de trabajo en el analisis
+    // de la traza. 0 desactiva el analisis.
+    std::size_t analyze_window;
+
+    // Mascara de las vias en que puede reemplazar cada tenant, al estilo
+    // de Intel CAT. 0 permite todas las vias. Si partitioned es false no
+    // se dio ninguna mascara y el reemplazo no cambia.
+    std::size_t way_masks[MAX_TENANTS];
+    bool partitioned;
+
+    // Si es true cada acceso se simula tambien con FastCache y se
+    // comparan los resultados.
+    bool validate;
+
+    // Si es true se comparan modelos sombra de la cache de datos con y
+    // sin compresion de lineas.
+    bool compress;
+
+    // Referencias del inicio de la traza que solo calientan la cache,
+    // sin contarse ni imprimirse.
+    std::size_t warmup;
+    // Si es true solo se simulan en detalle las referencias entre las
+    // marcas "// roi-begin" y "// roi-end" de la traza; las demas solo
+    // calientan la cache.
+    bool roi;
+
+    // Hilos que analizan la traza de texto. 0 usa uno por procesador.
+    std::size_t parse_threads;
+
+    // Archivo de la traza, o nullptr para leerla de la entrada estandar.
+    const char* trace_path;
+    // Archivo donde se escriben los resultados y su formato, o nullptr
+    // si solo se imprimen.
+    const char* results_path;
+    int results_format;
+
+    // Origen de los accesos: la traza en la entrada estandar, un anillo
+    // en memoria compartida o un socket Unix, con su nombre o ruta.
+    int input_source;
+    const char* input_name;
+
+    // Modo de simulacion por muestreo.
+    int sampling;
+    // Se simula uno de cada sampling_ratio conjuntos.
+    std::size_t sampling_ratio;
+    // Cada sampling_period referencias, las primeras sampling_window
+    // se simulan en detalle y el resto solo calienta la cache.
+    std::size_t sampling_period;
+    std::size_t sampling_window;
 };
 
 /**
@@ -33,6 +154,35 @@ struct CacheData
  */
 int analyze_arguments(int argc, char* argv[], CacheData* cache_data);
 
+/**
+ * Analiza los argumentos opcionales que vienen despues de los argumentos
+ * obligatorios, a partir de la posicion @a first.
+ * 
+ * @param argc          El numero de argumentos recibidos por linea de comandos.
+ * @param argv          Arreglo de argumentos recibidos por linea de comandos.
+ * @param first         Posicion del primer argumento opcional.
+ * @param cache_data    Datos para inicializar la cache.
+ */
+int analyze_options(int argc, char* argv[], int first, CacheData* cache_data);
+
+/**
+ * Lee el archivo de configuracion @a argv[2] y analiza sus valores como
+ * si fueran argumentos, seguidos de los argumentos a partir de argv[3].
+ * Cada linea del archivo tiene la forma "clave = valor". Las claves de
+ * los ocho argumentos obligatorios tienen su nombre (num_of_sets,
+ * replacement, etc.); cualquier otra clave es una opcion sin los
+ * guiones iniciales y con '_' en lugar de '-', y una opcion sin valores
+ * se activa con "true". Las lineas vacias y las que empiezan con '#'
+ * se ignoran. Una opcion de la linea de comandos reemplaza la misma
+ * opcion del archivo, y las que no se pueden combinar con ella (como
+ * --set-sampling y --time-sampling); --cat se agrega a las del archivo.
+ * 
+ * @param argc          El numero de argumentos recibidos por linea de comandos.
+ * @param argv          Arreglo de argumentos recibidos por linea de comandos.
+ * @param cache_data    Datos para inicializar la cache.
+ */
+int read_config_file(int argc, char* argv[], CacheData* cache_data);
+
 /**
  * Verifica si @a number es una potencia de 2.
  * 
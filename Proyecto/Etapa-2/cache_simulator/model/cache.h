@@ -5,10 +5,18 @@
 #ifndef CACHE_H
 #define CACHE_H
 
+#include "address_translator.h"
+#include "arena.h"
 #include "arguments.h"
+#include "dram_model.h"
+#include "latency_histogram.h"
+#include "miss_timing.h"
+#include "victim_cache.h"
 
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 
 #define LRU     0
@@ -17,8 +25,14 @@
 
 #define ADDRESS_LENGTH 32
 
-#define LOAD    'l'
-#define STORE   's'
+#define LOAD        'l'
+#define STORE       's'
+#define IFETCH      'i'
+#define PREFETCH    'p'
+#define FLUSH       'f'
+
+// Bytes que escribe en memoria un store con write-through.
+#define STORE_BYTES 4
 
 /**
  * Estructura que representa la informacion de cada acceso a memoria
@@ -27,9 +41,23 @@
 struct Access
 {
     char operation;
+    // Tenant (clase de servicio) que hace el acceso, menor que MAX_TENANTS.
+    unsigned char tenant;
+    // Si es true, value es el valor de la palabra leida o escrita.
+    bool has_value;
+    std::uint32_t value;
     std::size_t address;
 };
 
+/**
+ * Estructura que representa el resultado de un acceso a la cache.
+ */
+struct AccessResult
+{
+    bool hit;
+    std::size_t cycles;
+};
+
 /**
  * Clase Cache.
  * 
@@ -51,6 +79,11 @@ private:
         bool dirty;
         bool first_in;
         std::size_t lru_value;
+        // Orden en que se lleno el bloque, para FIFO con particiones.
+        std::size_t fill_order;
+        // Bits de valido y sucio de cada sector del bloque.
+        std::uint64_t sector_valid;
+        std::uint64_t sector_dirty;
     };
 
     /**
@@ -64,8 +97,49 @@ private:
         std::size_t load_miss_count;
         std::size_t store_hit_count;
         std::size_t store_miss_count;
+        std::size_t ifetch_hit_count;
+        std::size_t ifetch_miss_count;
+        std::size_t prefetch_hit_count;
+        std::size_t prefetch_miss_count;
+        std::size_t flush_count;
+        std::size_t flush_hit_count;
+        std::size_t writeback_count;
         std::size_t eviction_count;
         std::size_t total_cpu_cycles;
+        std::size_t victim_hit_count;
+        // Accesos cuyo bloque estaba pero no su sector, y bytes leidos
+        // y escritos en memoria.
+        std::size_t sector_miss_count;
+        std::size_t read_bytes;
+        std::size_t write_bytes;
+        // Hits, misses y desalojos provocados por cada tenant.
+        std::size_t tenant_hit_count[MAX_TENANTS];
+        std::size_t tenant_miss_count[MAX_TENANTS];
+        std::size_t tenant_eviction_count[MAX_TENANTS];
+    };
+
+    /**
+     * Estructura con el resultado de actualizar los bloques en un acceso.
+     */
+    struct BlockUpdate
+    {
+        bool hit;
+        bool evicted;
+        bool victim_hit;
+        std::size_t evicted_tag;
+        // Sectores sucios del bloque invalidado por un flush.
+        std::size_t dirty_sectors;
+    };
+
+    /**
+     * Estructura con el resultado de actualizar los sectores de un bloque.
+     */
+    struct SectorUpdate
+    {
+        // El bloque estaba pero no el sector del acceso.
+        bool sector_miss;
+        // Sectores sucios del bloque desalojado.
+        std::size_t written_sectors;
     };
 
     /**
@@ -99,12 +173,50 @@ private:
     std::size_t cache_access_cycles;
     std::size_t memory_access_cycles;
 
+    // Ciclos de acceso al victim cache o miss cache, y si se usa como miss cache.
+    std::size_t victim_access_cycles;
+    bool miss_cache;
+
+    // Si es true no se imprime el resultado de cada acceso.
+    bool quiet;
+
+    // Sectores por bloque (0 si no se usan) y bytes de cada sector.
+    std::size_t sector_count;
+    std::size_t sector_bytes;
+
+    // Vias en que puede reemplazar cada tenant. Un hit puede estar en
+    // cualquier via; la mascara solo limita donde se llena un miss.
+    std::size_t way_masks[MAX_TENANTS];
+    bool partitioned;
+    // Siguiente orden de llenado de un bloque.
+    std::size_t fill_counter;
+
     // Informacion de las direcciones de memoria.
     AddressInfo address_info;
     // Estado actual de la cache.
     CacheStatus status;
 
-    // Contenedor de la cache. Arreglo de punteros a bloques.
+    // Region de donde salen los bloques y los componentes opcionales.
+    Arena arena;
+
+    // Modelo de tiempo de la cache no bloqueante, o nullptr si es bloqueante.
+    MissTiming* timing;
+    // Traduccion de direcciones virtuales a fisicas, o nullptr, y si es
+    // de esta cache o la comparte otra.
+    AddressTranslator* translator;
+    bool owns_translator;
+    // Victim cache o miss cache de la cache direct-mapped, o nullptr.
+    VictimCache* victim_cache;
+    // Modelo de la memoria principal, o nullptr si cada acceso a memoria
+    // toma memory_access_cycles.
+    DramModel* dram;
+
+    // Latencias de cada load y de cada store.
+    LatencyHistogram* load_latency;
+    LatencyHistogram* store_latency;
+
+    // Contenedor de la cache. Arreglo de punteros a bloques, que apuntan
+    // a un solo arreglo contiguo de bloques en la arena.
     CacheBlock** blocks;
 
 // Metodos publicos
@@ -119,9 +231,28 @@ public:
     Cache(CacheData* cache_data);
 
     /**
-     * Destruye la cache.
+     * Retorna los bytes de arena que necesita una cache con los datos
+     * de @a cache_data, incluyendo sus componentes opcionales.
      */
-    ~Cache();
+    static std::size_t required_bytes(CacheData* cache_data);
+
+    /**
+     * Retorna true si se pudo reservar la memoria de la cache.
+     */
+    bool is_valid();
+
+    /**
+     * Invalida todos los bloques y reinicia los contadores del estado
+     * de la cache, conservando su geometria.
+     */
+    void reset();
+
+    /**
+     * Usa la traduccion de direcciones @a translator de otra cache, como
+     * la L1I con la de la cache de datos, para que las dos asignen los
+     * mismos marcos fisicos. reset() no reinicia la traduccion compartida.
+     */
+    void share_translator(AddressTranslator* translator);
 
     /**
      * Realiza los accesos a memoria y cache correspondientes, 
@@ -129,10 +260,40 @@ public:
      * Verifica si es miss o hit, invoca al algoritmo de reemplazo 
      * correspondiente e incrementa los contadores del estado de la cache.
      * 
+     * Los ifetch se tratan como loads. Un prefetch trae el bloque pero
+     * no detiene al procesador: solo cuesta el acceso a la cache. Un flush
+     * invalida el bloque, si esta, y lo escribe en memoria si esta sucio.
+     * 
+     * Con sectores, un acceso cuyo bloque esta pero no su sector es un
+     * miss que solo trae ese sector de memoria.
+     * 
      * @param reference Acceso que contiene la operacion y direccion
      * recibidas de la linea actual del archivo de la traza.
+     * @return Si el acceso fue hit y los ciclos que tomo.
+     */
+    AccessResult handle_reference(Access reference);
+
+    /**
+     * Actualiza el estado de los bloques con el acceso @a reference,
+     * sin imprimir ni incrementar los contadores del estado de la cache.
+     * Se usa para calentar la cache (functional warming).
+     * 
+     * @param reference Acceso que contiene la operacion y direccion.
      */
-    void handle_reference(Access reference);
+    void warm_reference(Access reference);
+
+    /**
+     * Retorna true si @a operation es una operacion valida de la traza.
+     */
+    static bool is_valid_operation(char operation);
+
+    /**
+     * Imprime el estado de los bloques del conjunto @a index.
+     */
+    void print_set(std::size_t index);
+
+    // Obtiene el index de una direccion.
+    std::size_t get_index(std::size_t address);
 
     // Getters
 
@@ -142,9 +303,49 @@ public:
     std::size_t get_load_miss_count();
     std::size_t get_store_hit_count();
     std::size_t get_store_miss_count();
+    std::size_t get_ifetch_hit_count();
+    std::size_t get_ifetch_miss_count();
+    std::size_t get_prefetch_hit_count();
+    std::size_t get_prefetch_miss_count();
+    std::size_t get_flush_count();
+    std::size_t get_flush_hit_count();
+    std::size_t get_writeback_count();
     std::size_t get_eviction_count();
     std::size_t get_total_cpu_cycles();
 
+    // Retornan los histogramas de latencias de loads y de stores.
+    LatencyHistogram* get_load_latency();
+    LatencyHistogram* get_store_latency();
+
+    // Retorna true si la cache cuenta sectores y trafico a memoria.
+    bool is_sectored();
+    std::size_t get_sector_count();
+    std::size_t get_sector_miss_count();
+    std::size_t get_read_bytes();
+    std::size_t get_write_bytes();
+
+    // Retorna true si se dio alguna mascara de vias.
+    bool is_partitioned();
+    std::size_t get_way_mask(std::size_t tenant);
+    std::size_t get_tenant_hit_count(std::size_t tenant);
+    std::size_t get_tenant_miss_count(std::size_t tenant);
+    std::size_t get_tenant_eviction_count(std::size_t tenant);
+
+    // Retorna la traduccion de direcciones, o nullptr si no se usa.
+    AddressTranslator* get_translator();
+
+    // Retorna el modelo de la memoria principal, o nullptr si no se usa.
+    DramModel* get_dram();
+
+    // Retorna true si la cache tiene victim cache o miss cache.
+    bool has_victim_cache();
+    std::size_t get_victim_hit_count();
+
+    // Retorna true si la cache usa el modelo no bloqueante con MSHRs.
+    bool is_non_blocking();
+    std::size_t get_mshr_merge_count();
+    std::size_t get_mshr_stall_cycles();
+
 // Metodos privados
 private:
 
@@ -152,16 +353,45 @@ private:
     void calculate_address_lengths();
     // Obtiene el tag de una direccion.
     std::size_t get_tag(std::size_t address);
-    // Obtiene el index de una direccion.
-    std::size_t get_index(std::size_t address);
 
     // Verifica si una direccion da un miss.
     bool is_miss(std::size_t tag, std::size_t index);
 
-    // Realizan los algoritmos de reemplazo.
-    void do_lru_replacement(std::size_t tag, std::size_t index);
-    void do_fifo_replacement(std::size_t tag, std::size_t index);
-    void do_random_replacement(std::size_t tag, std::size_t index);
+    // Actualiza los bloques con el tag e index de un acceso de @a tenant.
+    BlockUpdate update_blocks(std::size_t tag, std::size_t index,
+                              std::size_t tenant);
+    // Llena un miss de una cache fully-associative particionada, solo en
+    // las vias de @a mask. Retorna true si desalojo un bloque.
+    bool fill_partitioned(std::size_t tag, std::size_t mask,
+                          std::size_t* evicted_tag);
+    // Actualiza los sectores del bloque de @a tag despues de que
+    // update_blocks lo busco o lo lleno. @a block_hit indica si el bloque
+    // ya estaba; si no, solo queda valido el sector de @a address.
+    SectorUpdate update_sectors(std::size_t tag, std::size_t index,
+                                std::size_t address, bool block_hit, bool store);
+    // Realiza un flush del bloque con el tag e index de @a reference,
+    // a partir del resultado con los ciclos de traduccion ya sumados.
+    AccessResult handle_flush(Access reference, std::size_t tag,
+                              std::size_t index, AccessResult result);
+    // Suma los ciclos de una referencia al total, con o sin MSHRs.
+    void add_cycles(std::size_t address, bool hit, std::size_t cycles);
+
+    // Invalida el bloque con el tag e index de un flush. En el resultado,
+    // hit indica si el bloque estaba y evicted si estaba sucio.
+    BlockUpdate flush_block(std::size_t tag, std::size_t index);
+    // Busca en el victim cache o miss cache el bloque de un miss
+    // direct-mapped y lo actualiza. Retorna true si estaba.
+    bool probe_victim_cache(std::size_t tag, std::size_t index);
+
+    // Obtiene los ciclos de un acceso a memoria a @a address, que llega
+    // @a elapsed_cycles despues de empezar la referencia actual.
+    std::size_t memory_latency(std::size_t address, bool write,
+                               std::size_t elapsed_cycles);
+
+    // Realizan los algoritmos de reemplazo. Retornan el tag desalojado.
+    std::size_t do_lru_replacement(std::size_t tag, std::size_t index);
+    std::size_t do_fifo_replacement(std::size_t tag, std::size_t index);
+    std::size_t do_random_replacement(std::size_t tag, std::size_t index);
 
     // Actualiza el estado del bloque para efectos del algoritmo LRU.
     void update_lru_block(std::size_t tag, std::size_t index);
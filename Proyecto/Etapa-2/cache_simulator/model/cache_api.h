@@ -0,0 +1,125 @@
+/**
+ * Interfaz en C para usar el simulador de cache como biblioteca.
+ *
+ * Permite crear una cache a partir de una configuracion, alimentarla
+ * con lotes de accesos, consultar sus estadisticas y reiniciarla, sin
+ * pasar por el programa cache_simulator ni por archivos de texto.
+ */
+
+#ifndef CACHE_API_H
+#define CACHE_API_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Version de la interfaz. Cambia solo si se rompe la compatibilidad.
+#define CACHE_SIM_API_VERSION 2
+
+#define CACHE_SIM_LRU       0
+#define CACHE_SIM_FIFO      1
+#define CACHE_SIM_RANDOM    2
+
+#define CACHE_SIM_LOAD      'l'
+#define CACHE_SIM_STORE     's'
+#define CACHE_SIM_IFETCH    'i'
+#define CACHE_SIM_PREFETCH  'p'
+#define CACHE_SIM_FLUSH     'f'
+
+/**
+ * Cache opaca creada por cache_sim_create.
+ */
+typedef struct cache_sim cache_sim_t;
+
+/**
+ * Configuracion de la cache. Tiene las mismas restricciones que los
+ * argumentos de cache_simulator.
+ */
+typedef struct cache_sim_config
+{
+    size_t num_of_sets;
+    size_t num_of_set_blocks;
+    size_t num_of_block_bytes;
+    size_t cache_access_cycles;
+    size_t memory_access_cycles;
+    int write_allocate;
+    int write_through;
+    int replacement;
+} cache_sim_config_t;
+
+/**
+ * Un acceso a memoria: operacion (CACHE_SIM_LOAD, CACHE_SIM_STORE,
+ * CACHE_SIM_IFETCH, CACHE_SIM_PREFETCH o CACHE_SIM_FLUSH) y direccion
+ * de 32 bits.
+ */
+typedef struct cache_sim_access
+{
+    char operation;
+    size_t address;
+} cache_sim_access_t;
+
+/**
+ * Estadisticas acumuladas de la cache. Los ifetch, los prefetch y los
+ * flush se cuentan aparte desde la version 2 de la interfaz.
+ */
+typedef struct cache_sim_stats
+{
+    size_t load_hit_count;
+    size_t load_miss_count;
+    size_t store_hit_count;
+    size_t store_miss_count;
+    size_t eviction_count;
+    size_t total_cpu_cycles;
+    size_t ifetch_hit_count;
+    size_t ifetch_miss_count;
+    size_t prefetch_hit_count;
+    size_t prefetch_miss_count;
+    size_t flush_count;
+} cache_sim_stats_t;
+
+/**
+ * Retorna la version de la interfaz con la que se compilo la biblioteca.
+ */
+int cache_sim_api_version(void);
+
+/**
+ * Crea una cache con la configuracion @a config.
+ *
+ * @param config    Configuracion de la cache.
+ * @param error     Si no es NULL, recibe 0 o el codigo de error,
+ * con los mismos valores que retorna cache_simulator.
+ * @return La cache creada, o NULL si la configuracion es invalida.
+ */
+cache_sim_t* cache_sim_create(const cache_sim_config_t* config, int* error);
+
+/**
+ * Destruye una cache creada con cache_sim_create.
+ */
+void cache_sim_destroy(cache_sim_t* cache);
+
+/**
+ * Simula @a count accesos de @a accesses en orden.
+ *
+ * @return El numero de accesos simulados. Se detiene en el primer
+ * acceso con una operacion o direccion invalida.
+ */
+size_t cache_sim_access_batch(cache_sim_t* cache,
+                              const cache_sim_access_t* accesses, size_t count);
+
+/**
+ * Copia en @a stats las estadisticas acumuladas de la cache.
+ */
+void cache_sim_get_stats(cache_sim_t* cache, cache_sim_stats_t* stats);
+
+/**
+ * Invalida todos los bloques y reinicia las estadisticas de la cache.
+ */
+void cache_sim_reset(cache_sim_t* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CACHE_API_H */
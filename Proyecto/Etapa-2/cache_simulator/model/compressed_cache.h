@@ -0,0 +1,143 @@
+/**
+ * Encabezado de la clase CompressedCache.
+ */
+
+#ifndef COMPRESSED_CACHE_H
+#define COMPRESSED_CACHE_H
+
+#include "arguments.h"
+#include "cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Bytes de una palabra de los datos de la traza.
+#define WORD_BYTES 4
+
+// Bytes de una linea comprimida de solo ceros y de una linea con una
+// sola palabra repetida.
+#define ZERO_LINE_BYTES     1
+#define REPEATED_LINE_BYTES WORD_BYTES
+
+/**
+ * Clase CompressedCache.
+ *
+ * Modelo sombra de una cache que comprime sus lineas, con la misma
+ * geometria que la cache simulada. Cada conjunto tiene un presupuesto de
+ * bytes igual a sus bloques sin comprimir y el doble de tags, asi que
+ * caben mas lineas mientras se compriman. Las lineas se comprimen con
+ * deteccion de lineas de ceros y base-delta-immediate (BDI) sobre los
+ * valores de la traza; las palabras que la traza no ha dado valen 0. Usa
+ * reemplazo LRU y desaloja lineas hasta que la nueva quepa.
+ *
+ * Sin compresion, cada linea ocupa un bloque completo y el modelo es una
+ * cache LRU comun con la que se compara la tasa de misses.
+ */
+class CompressedCache
+{
+// Atributos privados
+private:
+    // Geometria, como en Cache.
+    std::size_t num_of_sets;
+    std::size_t num_of_block_bytes;
+    std::size_t offset_length;
+
+    // Si es false cada linea ocupa el bloque completo.
+    bool compress;
+    // Bytes y lineas que caben en cada conjunto.
+    std::size_t set_budget;
+    std::size_t set_lines;
+
+    // Tag, bytes, ultimo uso y validez de cada linea, conjunto por conjunto.
+    std::vector<std::size_t> tags;
+    std::vector<std::size_t> sizes;
+    std::vector<std::size_t> last_use;
+    std::vector<bool> valid;
+    // Bytes ocupados en cada conjunto.
+    std::vector<std::size_t> used_bytes;
+    // Contador de usos, para el reemplazo LRU.
+    std::size_t clock;
+
+    // Ultimo valor conocido de cada palabra, por direccion de palabra.
+    std::unordered_map<std::size_t, std::uint32_t> memory;
+    // Palabras de la linea que se esta comprimiendo, para no reservar
+    // memoria en cada acceso.
+    std::vector<std::uint32_t> line_words;
+
+    std::size_t hit_count;
+    std::size_t miss_count;
+    std::size_t eviction_count;
+
+    // Lineas validas ahora y su suma sobre todas las referencias, para
+    // la capacidad efectiva promedio.
+    std::size_t resident_lines;
+    std::size_t resident_sum;
+    std::size_t reference_count;
+
+    // Lineas traidas de memoria, sus bytes comprimidos y cuantas eran
+    // solo ceros.
+    std::size_t fill_count;
+    std::size_t fill_bytes;
+    std::size_t zero_line_count;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un modelo vacio con la geometria de @a cache_data.
+     *
+     * @param cache_data    Datos de la cache simulada.
+     * @param compress      Si es false las lineas no se comprimen.
+     */
+    CompressedCache(CacheData* cache_data, bool compress);
+
+    /**
+     * Simula @a reference. Si trae valor, actualiza primero la palabra,
+     * asi que un store cambia el tamano de su linea.
+     */
+    void handle_reference(Access reference);
+
+    /**
+     * Actualiza las lineas y los valores con @a reference sin cambiar
+     * las estadisticas.
+     */
+    void warm_reference(Access reference);
+
+    /**
+     * Retorna los bytes de @a word_count palabras comprimidas con la
+     * mejor codificacion: linea de ceros, palabra repetida o BDI con una
+     * base de 4 bytes y deltas de 1 o 2 bytes. Nunca mas que sin comprimir.
+     */
+    static std::size_t compressed_size(const std::uint32_t* words,
+                                       std::size_t word_count);
+
+    // Getters
+
+    bool is_compressed();
+    std::size_t get_hit_count();
+    std::size_t get_miss_count();
+    std::size_t get_eviction_count();
+    // Lineas que caben sin comprimir: bloques de la cache.
+    std::size_t get_capacity_lines();
+    // Promedio de lineas validas por referencia.
+    double get_average_resident_lines();
+    // Promedio de bytes comprimidos de las lineas traidas de memoria.
+    double get_average_line_bytes();
+    std::size_t get_zero_line_count();
+
+// Metodos privados
+private:
+
+    // Bytes que ocupa la linea @a line con los valores conocidos.
+    std::size_t line_size(std::size_t line);
+    // Desaloja lineas LRU de @a set, excepto @a keep, hasta que quepan
+    // @a bytes mas y haya una linea libre si @a need_line es true.
+    void make_room(std::size_t set, std::size_t bytes, bool need_line,
+                   std::size_t keep);
+    // Invalida la linea en la posicion @a position.
+    void remove_line(std::size_t set, std::size_t position);
+};
+
+#endif /* COMPRESSED_CACHE_H */
@@ -0,0 +1,143 @@
+/**
+ * Encabezado de la clase DramModel.
+ */
+
+#ifndef DRAM_MODEL_H
+#define DRAM_MODEL_H
+
+#include "arena.h"
+#include "arguments.h"
+
+#include <cstddef>
+
+/**
+ * Clase DramModel.
+ * 
+ * Modelo de la memoria principal detras de la cache. Reparte los
+ * bloques entre canales, rangos y bancos, lleva la fila abierta de cada
+ * banco (politica de pagina abierta o cerrada) y atiende las solicitudes
+ * de cada canal con una cola FR-FCFS: primero las que pegan en una fila
+ * abierta y luego las mas antiguas. Las escrituras se encolan sin esperar
+ * (posted writes); las lecturas esperan a que la cola las atienda.
+ * La latencia de cada lectura reemplaza al numero fijo de ciclos de
+ * acceso a memoria.
+ */
+class DramModel
+{
+// Estructuras privadas
+private:
+    /**
+     * Estructura que representa una solicitud en la cola de un canal.
+     */
+    struct DramRequest
+    {
+        std::size_t id;
+        std::size_t bank;
+        std::size_t row;
+        std::size_t arrival_cycle;
+        bool write;
+    };
+
+    /**
+     * Estructura que guarda el estado de un banco.
+     */
+    struct DramBank
+    {
+        bool row_open;
+        std::size_t open_row;
+        std::size_t ready_cycle;
+    };
+
+    /**
+     * Estructura que guarda el estado de un canal y su cola.
+     */
+    struct DramChannel
+    {
+        DramRequest* queue;
+        std::size_t queue_count;
+        std::size_t bus_ready_cycle;
+    };
+
+// Atributos privados
+private:
+    // Geometria.
+    std::size_t num_of_channels;
+    std::size_t num_of_ranks;
+    std::size_t num_of_banks;
+    std::size_t num_of_block_bytes;
+    std::size_t blocks_per_row;
+    std::size_t queue_depth;
+
+    // Tiempos en ciclos: activacion, lectura de columna, precarga
+    // y transferencia de un bloque.
+    std::size_t t_rcd;
+    std::size_t t_cas;
+    std::size_t t_rp;
+    std::size_t t_burst;
+    bool closed_page;
+
+    // Estado de los canales y de sus bancos (rangos por bancos por canal).
+    DramChannel* channels;
+    DramBank* banks;
+
+    // Estadisticas. request_count tambien numera las solicitudes.
+    std::size_t request_count;
+    std::size_t row_hit_count;
+    std::size_t row_conflict_count;
+    std::size_t first_arrival_cycle;
+    std::size_t last_completion_cycle;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye el modelo con los parametros de @a cache_data,
+     * con sus arreglos en @a arena.
+     */
+    DramModel(CacheData* cache_data, Arena* arena);
+
+    /**
+     * Retorna los bytes de arena que necesita el modelo.
+     */
+    static std::size_t required_bytes(CacheData* cache_data);
+
+    /**
+     * Cierra todas las filas, vacia las colas y reinicia las estadisticas.
+     */
+    void reset();
+
+    /**
+     * Envia una solicitud para el bloque de @a address.
+     * 
+     * @param address   Direccion fisica accesada.
+     * @param write     Si es una escritura.
+     * @param cycle     Ciclo en que llega la solicitud.
+     * @return Los ciclos que debe esperar la cache: hasta que llegan los
+     * datos en una lectura, o hasta que hay espacio en la cola en una escritura.
+     */
+    std::size_t access(std::size_t address, bool write, std::size_t cycle);
+
+    // Getters
+
+    std::size_t get_request_count();
+    std::size_t get_row_hit_count();
+    std::size_t get_row_conflict_count();
+    // Bytes transferidos por ciclo entre la primera solicitud y la ultima.
+    double get_bandwidth();
+
+// Metodos privados
+private:
+
+    // Posicion en la cola de @a channel de la siguiente solicitud segun
+    // FR-FCFS: la mas antigua que pega en una fila abierta, o la mas antigua.
+    std::size_t pick_next(std::size_t channel);
+    // Ciclo mas temprano en que puede empezar la siguiente solicitud del canal.
+    std::size_t next_start_cycle(std::size_t channel);
+    // Atiende la siguiente solicitud del canal. Retorna el ciclo en que
+    // termina y en @a served_id el numero de la solicitud atendida.
+    std::size_t serve_next(std::size_t channel, std::size_t* served_id);
+    // Banco de una solicitud del canal.
+    DramBank* get_bank(std::size_t channel, const DramRequest* request);
+};
+
+#endif /* DRAM_MODEL_H */
@@ -0,0 +1,113 @@
+/**
+ * Encabezado de la clase FastCache.
+ */
+
+#ifndef FAST_CACHE_H
+#define FAST_CACHE_H
+
+#include "arguments.h"
+#include "cache.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Clase FastCache.
+ *
+ * Motor optimizado del modelo basico de Cache: direct-mapped o
+ * fully-associative con LRU o FIFO, sin componentes opcionales y con
+ * accesos a memoria de ciclos fijos. En la fully-associative busca el
+ * tag en una tabla hash y mantiene el orden LRU en una lista doblemente
+ * enlazada, asi que cada acceso es O(1) en lugar de recorrer las vias.
+ * Debe dar exactamente los mismos resultados que Cache::handle_reference;
+ * el modo --validate los compara en cada acceso.
+ */
+class FastCache
+{
+// Atributos privados
+private:
+    // Geometria y politicas, como en Cache.
+    std::size_t num_of_sets;
+    std::size_t num_of_set_blocks;
+    std::size_t offset_length;
+    std::size_t index_length;
+    int replacement_algorithm;
+    std::size_t cache_access_cycles;
+    std::size_t memory_access_cycles;
+
+    // Tag de cada bloque (conjunto por conjunto) y si es valido.
+    std::vector<std::size_t> tags;
+    std::vector<bool> valid;
+
+    // Fully-associative: via de cada tag valido y bloques validos.
+    std::unordered_map<std::size_t, std::size_t> way_of_tag;
+    std::size_t valid_count;
+
+    // LRU: lista de vias de la mas a la menos recientemente usada.
+    std::vector<std::size_t> newer;
+    std::vector<std::size_t> older;
+    std::size_t most_recent;
+    std::size_t least_recent;
+
+    // FIFO: banderas first_in como las de Cache. Casi siempre hay una
+    // sola, en first_in_way; si hay mas, se busca la de menor via.
+    std::vector<bool> first_in;
+    std::size_t first_in_count;
+    std::size_t first_in_way;
+
+    // Desalojos y ciclos totales.
+    std::size_t eviction_count;
+    std::size_t total_cpu_cycles;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un motor con la geometria de @a cache_data.
+     */
+    FastCache(CacheData* cache_data);
+
+    /**
+     * Retorna true si el modelo basico cubre todas las opciones de
+     * @a cache_data, o false si usan algo que este motor no simula.
+     */
+    static bool supports(CacheData* cache_data);
+
+    /**
+     * Simula @a reference como Cache::handle_reference, sin imprimir.
+     */
+    AccessResult handle_reference(Access reference);
+
+    /**
+     * Actualiza los bloques con @a reference sin contar desalojos ni
+     * ciclos, como Cache::warm_reference.
+     */
+    void warm_reference(Access reference);
+
+    /**
+     * Imprime el estado del conjunto @a index.
+     */
+    void print_set(std::size_t index);
+
+    // Getters
+
+    std::size_t get_eviction_count();
+    std::size_t get_total_cpu_cycles();
+
+// Metodos privados
+private:
+
+    // Accesos a un bloque de una cache fully-associative.
+    bool access_associative(std::size_t tag, bool* evicted);
+    bool flush_associative(std::size_t tag);
+
+    // Operaciones de la lista LRU.
+    void unlink_way(std::size_t way);
+    void push_most_recent(std::size_t way);
+
+    // Pone la bandera first_in de @a way.
+    void set_first_in(std::size_t way);
+};
+
+#endif /* FAST_CACHE_H */
@@ -0,0 +1,102 @@
+/**
+ * Encabezado de la clase LatencyHistogram.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include "arena.h"
+
+#include <cstddef>
+
+// Bits de cada rango de potencias de 2 que se separan en sub-buckets.
+// Con 7 bits el error relativo de un valor es menor que 1/128.
+#define LATENCY_SUB_BITS    7
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+// Buckets para cualquier valor de 64 bits: los primeros valores son
+// exactos y cada potencia de 2 siguiente tiene LATENCY_SUB_BUCKETS.
+#define LATENCY_BUCKETS     ((65 - LATENCY_SUB_BITS) * LATENCY_SUB_BUCKETS)
+
+/**
+ * Clase LatencyHistogram.
+ * 
+ * Histograma log-lineal de latencias al estilo de HdrHistogram. Los
+ * valores menores que 2 * LATENCY_SUB_BUCKETS tienen un bucket propio;
+ * los mayores caen en LATENCY_SUB_BUCKETS buckets lineales por cada
+ * potencia de 2. La memoria es fija y agregar un valor solo cuesta
+ * contar sus bits y sumar 1.
+ */
+class LatencyHistogram
+{
+// Atributos privados
+private:
+    // Valores de cada bucket.
+    std::size_t* counts;
+    // Numero de valores y el mayor.
+    std::size_t total_count;
+    std::size_t max_value;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un histograma vacio, con sus buckets en @a arena.
+     */
+    LatencyHistogram(Arena* arena);
+
+    /**
+     * Retorna los bytes de arena que necesita el histograma.
+     */
+    static std::size_t required_bytes();
+
+    /**
+     * Vacia todos los buckets.
+     */
+    void reset();
+
+    /**
+     * Agrega la latencia @a value.
+     */
+    void record(std::size_t value)
+    {
+        ++this->counts[bucket_of(value)];
+        ++this->total_count;
+
+        if (value > this->max_value)
+        {
+            this->max_value = value;
+        }
+    }
+
+    /**
+     * Retorna la latencia del percentil @a percentile (de 0 a 100): el
+     * mayor valor del bucket donde se alcanza ese porcentaje de los
+     * valores, sin pasar del maximo. Retorna 0 si no hay valores.
+     */
+    std::size_t get_percentile(double percentile);
+
+    // Getters
+
+    std::size_t get_total_count();
+    std::size_t get_max_value();
+
+// Metodos privados
+private:
+
+    // Obtiene el bucket de @a value.
+    static std::size_t bucket_of(std::size_t value)
+    {
+        if (value < LATENCY_SUB_BUCKETS)
+        {
+            return value;
+        }
+
+        std::size_t shift = (63 - __builtin_clzl(value)) - LATENCY_SUB_BITS;
+        return shift * LATENCY_SUB_BUCKETS + (value >> shift);
+    }
+
+    // Obtiene el mayor valor que cae en @a bucket.
+    static std::size_t highest_value_of(std::size_t bucket);
+};
+
+#endif /* LATENCY_HISTOGRAM_H */
@@ -0,0 +1,92 @@
+/**
+ * Encabezado de la clase MissTiming.
+ */
+
+#ifndef MISS_TIMING_H
+#define MISS_TIMING_H
+
+#include "arena.h"
+
+#include <cstddef>
+
+/**
+ * Clase MissTiming.
+ * 
+ * Modelo de tiempo para una cache no bloqueante. Las referencias se
+ * emiten en orden, a lo sumo una por ciclo, dentro de una ventana
+ * fuera de orden de tamano fijo. Cada miss ocupa un MSHR hasta que
+ * llega el bloque, y los accesos a un bloque que sigue en camino se
+ * fusionan con su MSHR en lugar de esperar su propio acceso a memoria.
+ * El total de ciclos es el ciclo en que termina la ultima referencia.
+ */
+class MissTiming
+{
+// Estructuras privadas
+private:
+    /**
+     * Estructura que representa un MSHR (miss status holding register).
+     */
+    struct MissEntry
+    {
+        std::size_t line;
+        std::size_t completion_cycle;
+    };
+
+// Atributos privados
+private:
+    // MSHRs y su cantidad.
+    MissEntry* entries;
+    std::size_t entry_count;
+
+    // Ciclo en que termina cada referencia de la ventana, como anillo.
+    std::size_t* window;
+    std::size_t window_size;
+
+    // Numero de referencias emitidas.
+    std::size_t access_count;
+    // Ciclo mas temprano en que se puede emitir la siguiente referencia.
+    std::size_t next_issue_cycle;
+    // Ciclo en que termina la ultima referencia.
+    std::size_t finish_cycle;
+
+    // Estadisticas.
+    std::size_t merge_count;
+    std::size_t stall_cycles;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye el modelo con @a entry_count MSHRs y una ventana
+     * de @a window_size referencias, con sus arreglos en @a arena.
+     */
+    MissTiming(std::size_t entry_count, std::size_t window_size, Arena* arena);
+
+    /**
+     * Retorna los bytes de arena que necesita el modelo.
+     */
+    static std::size_t required_bytes(std::size_t entry_count,
+                                      std::size_t window_size);
+
+    /**
+     * Libera todos los MSHRs y vuelve al ciclo 0.
+     */
+    void reset();
+
+    /**
+     * Emite una referencia al bloque @a line.
+     * 
+     * @param line      Direccion del bloque (sin el offset).
+     * @param hit       Si la referencia fue hit en la cache.
+     * @param latency   Ciclos que tomaria la referencia en una cache bloqueante.
+     * @return El ciclo en que termina la ultima referencia emitida hasta ahora.
+     */
+    std::size_t add_access(std::size_t line, bool hit, std::size_t latency);
+
+    // Getters
+
+    std::size_t get_merge_count();
+    std::size_t get_stall_cycles();
+};
+
+#endif /* MISS_TIMING_H */
@@ -0,0 +1,71 @@
+/**
+ * Encabezado de la clase PerfCounters.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+
+#define PERF_CYCLES         0
+#define PERF_INSTRUCTIONS   1
+#define PERF_LLC_MISSES     2
+#define PERF_BRANCH_MISSES  3
+#define PERF_COUNTER_COUNT  4
+
+/**
+ * Clase PerfCounters.
+ * 
+ * Mide una fase del simulador con los contadores de hardware de Linux
+ * (perf_event_open): ciclos, instrucciones, misses del ultimo nivel de
+ * cache y branch misses. Si el sistema no permite abrir los contadores,
+ * solo mide el tiempo real transcurrido.
+ */
+class PerfCounters
+{
+// Atributos privados
+private:
+    // Descriptor de cada contador, o -1 si no se pudo abrir.
+    int descriptors[PERF_COUNTER_COUNT];
+    // Valores acumulados de cada contador.
+    std::uint64_t values[PERF_COUNTER_COUNT];
+    // Si se pudieron abrir todos los contadores.
+    bool available;
+
+    // Tiempo real acumulado y momento de inicio de la medicion actual.
+    double wall_seconds;
+    double start_seconds;
+
+// Metodos publicos
+public:
+
+    /**
+     * Abre los contadores de hardware para el proceso actual. Los
+     * contadores incluyen los hilos que el proceso cree despues de
+     * abrirlos, asi que se deben construir antes de crearlos.
+     */
+    PerfCounters();
+
+    /**
+     * Cierra los contadores.
+     */
+    ~PerfCounters();
+
+    /**
+     * Empieza a medir.
+     */
+    void start();
+
+    /**
+     * Deja de medir y acumula los valores medidos.
+     */
+    void stop();
+
+    // Getters
+
+    bool is_available();
+    double get_wall_seconds();
+    std::uint64_t get_value(int counter);
+};
+
+#endif /* PERF_COUNTERS_H */
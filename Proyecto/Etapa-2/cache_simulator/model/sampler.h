@@ -0,0 +1,131 @@
+/**
+ * Encabezado de la clase Sampler.
+ */
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include "arguments.h"
+#include "cache.h"
+
+#include <cstddef>
+
+/**
+ * Clase Sampler.
+ * 
+ * Simula solo una muestra de las referencias de la traza, ya sea
+ * por conjuntos (set sampling) o por ventanas periodicas de tiempo
+ * con calentamiento funcional (time sampling, al estilo SMARTS),
+ * y estima la tasa de hits y los ciclos totales con intervalos
+ * de confianza del 95%.
+ */
+class Sampler
+{
+// Estructuras privadas
+private:
+    /**
+     * Estructura que acumula los resultados de una unidad de muestreo
+     * (un conjunto o una ventana detallada).
+     */
+    struct SampleUnit
+    {
+        std::size_t reference_count;
+        std::size_t hit_count;
+        std::size_t cycle_count;
+    };
+
+    /**
+     * Estructura que acumula las sumas necesarias para el estimador
+     * de razon (ratio estimator) sobre todas las unidades muestreadas.
+     */
+    struct SampleSums
+    {
+        double unit_count;
+        double references;
+        double references_squared;
+        double hits;
+        double hits_squared;
+        double references_hits;
+        double cycles;
+        double cycles_squared;
+        double references_cycles;
+    };
+
+// Atributos privados
+private:
+    // Cache que simula las referencias muestreadas.
+    Cache* cache;
+    // Modo de muestreo.
+    int mode;
+
+    // Parametros del muestreo.
+    std::size_t ratio;
+    std::size_t period;
+    std::size_t window;
+
+    // Total de referencias leidas y referencias simuladas en detalle.
+    std::size_t total_reference_count;
+    std::size_t sampled_reference_count;
+
+    // Unidades de muestreo. En set sampling hay una por conjunto
+    // muestreado; en time sampling solo la ventana actual.
+    SampleUnit* units;
+    std::size_t unit_count;
+
+    // Sumas de las unidades ya cerradas.
+    SampleSums sums;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un objeto Sampler sobre @a cache con los parametros
+     * de muestreo de @a cache_data.
+     * 
+     * @param cache         Cache que simula las referencias muestreadas.
+     * @param cache_data    struct con los parametros del muestreo.
+     */
+    Sampler(Cache* cache, CacheData* cache_data);
+
+    /**
+     * Destruye el objeto Sampler.
+     */
+    ~Sampler();
+
+    /**
+     * Decide si @a reference se simula en detalle, solo calienta la cache
+     * o se descarta, y acumula su resultado en la unidad correspondiente.
+     * 
+     * @param reference Acceso recibido de la linea actual de la traza.
+     */
+    void handle_reference(Access reference);
+
+    /**
+     * Cierra las unidades de muestreo pendientes. Se debe invocar
+     * despues de leer toda la traza y antes de consultar las estimaciones.
+     */
+    void finish();
+
+    // Getters
+
+    std::size_t get_total_reference_count();
+    std::size_t get_sampled_reference_count();
+    std::size_t get_unit_count();
+
+    // Estimaciones con su margen de error (95% de confianza).
+    double get_hit_rate();
+    double get_hit_rate_margin();
+    double get_total_cpu_cycles();
+    double get_total_cpu_cycles_margin();
+
+// Metodos privados
+private:
+
+    // Acumula una unidad cerrada en las sumas.
+    void add_unit(SampleUnit* unit);
+    // Calcula el margen de error del estimador de razon para una metrica.
+    double ratio_margin(double value, double value_squared,
+                        double references_value);
+};
+
+#endif /* SAMPLER_H */
@@ -0,0 +1,168 @@
+/**
+ * Encabezado de la clase TraceAnalyzer.
+ */
+
+#ifndef TRACE_ANALYZER_H
+#define TRACE_ANALYZER_H
+
+#include "arguments.h"
+#include "cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Intervalos de la distancia de reuso y del stride: el 0 y luego
+// uno por cada potencia de 2.
+#define REUSE_BUCKETS   34
+#define STRIDE_BUCKETS  34
+
+// Maximo de bloques que sigue el muestreo de la distancia de reuso.
+#define ANALYSIS_MAX_LINES 8192
+
+// Bits de indice de los registros del HyperLogLog.
+#define HLL_PRECISION 12
+
+/**
+ * Clase TraceAnalyzer.
+ *
+ * Caracteriza la traza en la misma pasada que la simulacion, a la
+ * granularidad de los bloques de la cache y con memoria acotada:
+ * histograma de distancias de reuso muestreado al estilo SHARDS
+ * (tasa de muestreo fija que baja cuando se siguen demasiados bloques),
+ * conjunto de trabajo por ventanas y bloques distintos con HyperLogLog,
+ * razon de loads y stores, e histograma de strides entre accesos
+ * consecutivos.
+ */
+class TraceAnalyzer
+{
+// Atributos privados
+private:
+    // Bits del offset de bloque y bloques de la cache simulada.
+    std::size_t offset_bits;
+    std::size_t cache_lines;
+
+    // Conteos de referencias.
+    std::size_t reference_count;
+    std::size_t load_count;
+    std::size_t store_count;
+
+    // Muestreo de la distancia de reuso. Se sigue un bloque si su hash
+    // es menor que el umbral; la tasa de muestreo es umbral / 2^24.
+    std::uint32_t threshold;
+    std::size_t sampled_reference_count;
+    // Posicion del ultimo acceso de cada bloque seguido.
+    std::unordered_map<std::size_t, std::size_t> last_slot;
+    // Bloques seguidos ordenados por hash, para bajar el umbral.
+    std::set<std::pair<std::uint32_t, std::size_t> > tracked;
+    // Bloque del ultimo acceso en cada posicion, o invalido si ya
+    // se accesaron de nuevo.
+    std::vector<std::size_t> slot_lines;
+    // Arbol de Fenwick que cuenta las posiciones validas.
+    std::vector<std::size_t> slot_tree;
+    std::size_t next_slot;
+
+    // Histograma ponderado por el inverso de la tasa de muestreo.
+    double reuse_weights[REUSE_BUCKETS];
+    double cold_weight;
+    double lru_miss_weight;
+    double total_weight;
+
+    // Registros del HyperLogLog de toda la traza y de la ventana actual.
+    std::uint8_t total_registers[1 << HLL_PRECISION];
+    std::uint8_t window_registers[1 << HLL_PRECISION];
+
+    // Ventanas del conjunto de trabajo.
+    std::size_t window;
+    std::size_t window_reference_count;
+    std::size_t window_count;
+    double window_sum;
+    double window_min;
+    double window_max;
+
+    // Histograma de strides, en bloques, entre accesos consecutivos.
+    bool has_previous;
+    std::size_t previous_line;
+    std::size_t positive_strides[STRIDE_BUCKETS];
+    std::size_t negative_strides[STRIDE_BUCKETS];
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un analizador para los bloques y las ventanas
+     * de @a cache_data.
+     */
+    TraceAnalyzer(CacheData* cache_data);
+
+    /**
+     * Agrega @a reference a todas las estadisticas.
+     */
+    void handle_reference(Access reference);
+
+    /**
+     * Cierra la ventana pendiente. Se debe invocar despues de leer
+     * toda la traza y antes de consultar los resultados.
+     */
+    void finish();
+
+    // Getters
+
+    std::size_t get_block_bytes();
+    std::size_t get_cache_lines();
+    std::size_t get_reference_count();
+    std::size_t get_load_count();
+    std::size_t get_store_count();
+
+    // Bloques distintos estimados en toda la traza.
+    double get_unique_line_count();
+
+    std::size_t get_window();
+    std::size_t get_window_count();
+    double get_window_average();
+    double get_window_min();
+    double get_window_max();
+
+    double get_sampling_rate();
+    std::size_t get_sampled_reference_count();
+    // Fraccion de las referencias con distancia en el intervalo @a bucket:
+    // 0 para la distancia 0, o [2^(bucket-1), 2^bucket - 1].
+    double get_reuse_fraction(std::size_t bucket);
+    // Fraccion de las referencias al primer acceso de un bloque.
+    double get_cold_fraction();
+    // Tasa de misses estimada de una cache fully-associative LRU
+    // con los mismos bloques que la cache simulada.
+    double get_lru_miss_ratio();
+
+    // Strides con magnitud en el intervalo @a bucket, hacia direcciones
+    // mayores o (si @a negative) menores.
+    std::size_t get_stride_count(std::size_t bucket, bool negative);
+
+// Metodos privados
+private:
+
+    // Actualiza el histograma de distancias de reuso con el bloque @a line.
+    void update_reuse(std::size_t line, std::uint64_t hash);
+    // Deja de seguir los bloques con hash mayor o igual que el nuevo umbral.
+    void lower_threshold();
+    // Reasigna las posiciones validas desde 0 cuando se acaban.
+    void compact_slots();
+    // Operaciones del arbol de Fenwick.
+    void add_slot(std::size_t slot, long delta);
+    std::size_t count_slots(std::size_t slot);
+
+    // Cierra la ventana actual del conjunto de trabajo.
+    void close_window();
+
+    // Agrega un hash a los registros y estima su cardinalidad.
+    static void add_hash(std::uint8_t* registers, std::uint64_t hash);
+    static double estimate(const std::uint8_t* registers);
+
+    // Intervalo de una magnitud: 0 para 0, o floor(log2(value)) + 1.
+    static std::size_t bucket_of(std::size_t value);
+};
+
+#endif /* TRACE_ANALYZER_H */
@@ -0,0 +1,145 @@
+/**
+ * Encabezado de la clase TraceParser.
+ */
+
+#ifndef TRACE_PARSER_H
+#define TRACE_PARSER_H
+
+#include "cache.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Bytes que se leen de la traza para cada bloque, antes de recortarlo
+// en el ultimo cambio de linea.
+#define TRACE_CHUNK_BYTES (1 << 20)
+
+// Resultados de analizar una linea de la traza.
+#define TRACE_ACCESS    0
+#define TRACE_COMMENT   1
+#define TRACE_ERROR     2
+// Comentarios "// roi-begin" y "// roi-end", que marcan la region de interes.
+#define TRACE_ROI_BEGIN 3
+#define TRACE_ROI_END   4
+
+/**
+ * Bloque de lineas completas de la traza y los accesos que se obtuvieron
+ * de ellas.
+ */
+struct TraceChunk
+{
+    // Texto del bloque. Cada cambio de linea se cambia por '\0' al analizarlo.
+    std::vector<char> text;
+    // Accesos validos del bloque, en orden.
+    std::vector<Access> accesses;
+    // Lineas con error de sintaxis: cuantos accesos validos las preceden
+    // en el bloque y el numero de la linea en la traza.
+    std::vector<std::pair<std::size_t, std::size_t> > errors;
+    // Marcas de la region de interes: cuantos accesos validos las
+    // preceden en el bloque y si es TRACE_ROI_BEGIN o TRACE_ROI_END.
+    std::vector<std::pair<std::size_t, int> > markers;
+    // Numero de lineas del bloque.
+    std::size_t line_count;
+    // Estado del bloque en el anillo de bloques.
+    int state;
+};
+
+/**
+ * Clase TraceParser.
+ *
+ * Analiza una traza de texto con varios hilos. Un hilo lector corta la
+ * traza en bloques de lineas completas, los hilos analizadores convierten
+ * cada bloque en un arreglo de accesos y el consumidor los recibe en el
+ * orden de la traza con next_chunk(), con los numeros de linea de los
+ * errores ya calculados. Los bloques se reciclan en un anillo, asi que la
+ * memoria no crece con el largo de la traza.
+ */
+class TraceParser
+{
+// Atributos privados
+private:
+    // Descriptor del que se lee la traza.
+    int file;
+
+    // Anillo de bloques. El bloque numero k usa la posicion k % tamano.
+    std::vector<TraceChunk> chunks;
+
+    std::mutex mutex;
+    // Se avisa cuando un bloque cambia de estado.
+    std::condition_variable changed;
+
+    // Siguiente bloque que lee el lector, que analiza un analizador
+    // y que recibe el consumidor.
+    std::size_t next_read;
+    std::size_t next_parse;
+    std::size_t next_consume;
+    // Si es true el lector ya llego al final de la traza.
+    bool end_of_file;
+    // Si es true los hilos deben terminar.
+    bool stopping;
+
+    // Lineas de los bloques que ya recibio el consumidor.
+    std::size_t consumed_lines;
+
+    std::thread reader;
+    std::vector<std::thread> parsers;
+
+// Metodos publicos
+public:
+
+    /**
+     * Empieza a leer la traza de @a file y a analizarla con
+     * @a thread_count hilos, o uno por procesador si es 0.
+     */
+    TraceParser(int file, std::size_t thread_count);
+
+    /**
+     * Detiene y espera a los hilos.
+     */
+    ~TraceParser();
+
+    /**
+     * Espera el siguiente bloque de la traza, en orden.
+     *
+     * @return El bloque, o nullptr si ya no hay mas. Se debe devolver
+     * con release_chunk antes de pedir el siguiente.
+     */
+    TraceChunk* next_chunk();
+
+    /**
+     * Devuelve al anillo el bloque que retorno next_chunk.
+     */
+    void release_chunk(TraceChunk* chunk);
+
+    /**
+     * Analiza una linea de la traza.
+     *
+     * @param line      Linea de la traza, terminada en '\0'.
+     * @param access    Recibe el acceso de la linea.
+     * @return TRACE_ACCESS, TRACE_COMMENT, TRACE_ERROR, TRACE_ROI_BEGIN
+     * o TRACE_ROI_END.
+     */
+    static int parse_line(const char* line, Access* access);
+
+    /**
+     * Retorna el numero de hilos analizadores por omision: uno por
+     * procesador.
+     */
+    static std::size_t default_thread_count();
+
+// Metodos privados
+private:
+
+    // Ciclo del hilo lector.
+    void read_chunks();
+    // Ciclo de cada hilo analizador.
+    void parse_chunks();
+    // Convierte el texto de @a chunk en accesos.
+    static void parse_chunk(TraceChunk* chunk);
+};
+
+#endif /* TRACE_PARSER_H */
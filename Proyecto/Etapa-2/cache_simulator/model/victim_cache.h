@@ -0,0 +1,70 @@
+/**
+ * Encabezado de la clase VictimCache.
+ */
+
+#ifndef VICTIM_CACHE_H
+#define VICTIM_CACHE_H
+
+#include "arena.h"
+
+#include <cstddef>
+
+/**
+ * Clase VictimCache.
+ * 
+ * Buffer pequeno y fully-associative junto a una cache direct-mapped.
+ * Como victim cache guarda los bloques desalojados de la cache y los
+ * intercambia cuando vuelven a ser accesados; como miss cache guarda
+ * los bloques traidos de memoria en cada miss. Usa reemplazo LRU.
+ * Las direcciones de los bloques estan en un arreglo contiguo para que
+ * la busqueda lineal sea rapida.
+ */
+class VictimCache
+{
+// Atributos privados
+private:
+    // Direccion del bloque (sin el offset) de cada entrada.
+    std::size_t* lines;
+    // Ultimo uso de cada entrada, para el reemplazo LRU.
+    std::size_t* last_use;
+    // Numero de entradas.
+    std::size_t entry_count;
+    // Contador de usos.
+    std::size_t clock;
+
+// Metodos publicos
+public:
+
+    /**
+     * Construye un buffer vacio de @a entry_count entradas,
+     * con sus arreglos en @a arena.
+     */
+    VictimCache(std::size_t entry_count, Arena* arena);
+
+    /**
+     * Retorna los bytes de arena que necesita el buffer.
+     */
+    static std::size_t required_bytes(std::size_t entry_count);
+
+    /**
+     * Invalida todas las entradas.
+     */
+    void reset();
+
+    /**
+     * Busca el bloque @a line en el buffer.
+     * 
+     * @param line      Direccion del bloque.
+     * @param remove    Si es true y el bloque esta, se saca del buffer.
+     * @return true si el bloque estaba en el buffer.
+     */
+    bool lookup(std::size_t line, bool remove);
+
+    /**
+     * Agrega el bloque @a line en una entrada libre o en la menos
+     * recientemente usada.
+     */
+    void insert(std::size_t line);
+};
+
+#endif /* VICTIM_CACHE_H */
@@ -0,0 +1,167 @@
+/**
+ * Prueba de que la cache no reserva memoria despues de crearse.
+ *
+ * Se enlaza contra la biblioteca con -Wl,--wrap=malloc,--wrap=free y
+ * reemplaza los operadores new, asi que cuenta toda reserva de memoria
+ * hecha durante los accesos y los reset de varias configuraciones.
+ */
+
+#include "../model/cache.h"
+
+#include <cstdlib>
+#include <new>
+
+extern "C" void* __real_malloc(std::size_t size);
+extern "C" void __real_free(void* pointer);
+
+// Reservas hechas mientras counting es true.
+static std::size_t allocation_count = 0;
+static bool counting = false;
+
+extern "C" void* __wrap_malloc(std::size_t size)
+{
+    if (counting)
+    {
+        ++allocation_count;
+    }
+    return __real_malloc(size);
+}
+
+extern "C" void __wrap_free(void* pointer)
+{
+    __real_free(pointer);
+}
+
+void* operator new(std::size_t size)
+{
+    void* pointer = __wrap_malloc(size > 0 ? size : 1);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return __wrap_malloc(size > 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return __wrap_malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+// Referencias simuladas entre cada reset.
+#define REFERENCE_COUNT 100000
+
+/**
+ * Configuraciones probadas: geometria, reemplazo y componentes opcionales.
+ */
+struct AllocConfig
+{
+    std::size_t num_of_sets;
+    std::size_t num_of_set_blocks;
+    std::size_t num_of_block_bytes;
+    int replacement;
+    std::size_t mshr_count;
+    std::size_t victim_entries;
+    std::size_t sector_count;
+};
+
+static const AllocConfig configs[] = {
+    {1024, 1, 64, LRU, 0, 0, 0},
+    {1, 16, 32, LRU, 0, 0, 0},
+    {1, 16, 32, FIFO, 0, 0, 0},
+    {1, 8, 16, RANDOM, 0, 0, 0},
+    {256, 1, 32, LRU, 4, 8, 0},
+    {1, 4, 64, LRU, 0, 0, 8}
+};
+
+/**
+ * Simula REFERENCE_COUNT accesos seudoaleatorios con @a cache y la
+ * reinicia, dos veces.
+ */
+static void run_references(Cache* cache)
+{
+    const char operations[] = {LOAD, STORE, IFETCH, PREFETCH, FLUSH};
+    std::uint32_t state = 1;
+
+    for (int round = 0; round < 2; ++round)
+    {
+        for (std::size_t index = 0; index < REFERENCE_COUNT; ++index)
+        {
+            state = state * 1664525 + 1013904223u;
+
+            Access reference = Access();
+            reference.operation = operations[(state >> 8) % 5];
+            reference.address = ((state >> 12) % 65536) * 4;
+            cache->handle_reference(reference);
+        }
+
+        cache->reset();
+    }
+}
+
+int main()
+{
+    int error = 0;
+
+    for (const AllocConfig& config : configs)
+    {
+        CacheData cache_data = CacheData();
+        cache_data.num_of_sets = config.num_of_sets;
+        cache_data.num_of_set_blocks = config.num_of_set_blocks;
+        cache_data.num_of_block_bytes = config.num_of_block_bytes;
+        cache_data.cache_access_cycles = 13;
+        cache_data.memory_access_cycles = 230;
+        cache_data.write_through = true;
+        cache_data.replacement = config.replacement;
+        cache_data.quiet = true;
+        cache_data.mshr_count = config.mshr_count;
+        cache_data.mshr_window = 16;
+        cache_data.victim_entries = config.victim_entries;
+        cache_data.victim_access_cycles = 1;
+        cache_data.sector_count = config.sector_count;
+
+        Cache* cache = new Cache(&cache_data);
+        if (!(cache->is_valid()))
+        {
+            std::cout << "test-alloc: could not create the cache\n";
+            return 12;
+        }
+
+        allocation_count = 0;
+        counting = true;
+        run_references(cache);
+        counting = false;
+
+        std::cout << "test-alloc: " << config.num_of_sets << " "
+                  << config.num_of_set_blocks << " " << config.num_of_block_bytes
+                  << ": " << allocation_count << " allocations\n";
+
+        if (allocation_count != 0)
+        {
+            error = 1;
+        }
+
+        delete cache;
+    }
+
+    return error;
+}